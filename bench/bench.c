@@ -0,0 +1,157 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "rmt_sim.h"
+#include "spi_sim.h"
+
+/*
+    led_strip_bench [filter]
+    led_strip_bench_stats [filter]
+
+    filter = substring of "<group>/<case>" to run
+
+    led_strip_bench_stats runs the same cases against a
+    LED_STRIP_STATS build: slower, but fills the measured
+    refill-interrupt columns (isr us, isr load)
+*/
+
+static const size_t k_lengths[] = { 60, 300, 1000, 3000, 10000 };
+
+/* Pixel operations per measurement (keeps every row ~equal cost) */
+#define PIXEL_BUDGET   4000000u
+#define MIN_ITERATIONS 8u
+
+static const bench_group_t *const k_groups[] = {
+    &bench_pipeline,
+    &bench_dither,
+    &bench_fx,
+    &bench_layer,
+    &bench_map,
+    &bench_rmt,
+    &bench_spi,
+    &bench_queue,
+    &bench_dmx,
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Wire counters of either backend (SPI: bits as symbols, no refills) */
+static void wire_stats(const led_strip_t *strip, rmt_sim_stats_t *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    if (strip->backend == LED_STRIP_BACKEND_SPI) {
+        spi_sim_stats_t spi;
+        spi_sim_get_stats(strip->spi, &spi);
+        out->symbols = spi.bytes * 8;
+        out->wire_ns = spi.wire_ns;
+        out->last_wire_ns = spi.last_wire_ns;
+        return;
+    }
+
+    rmt_sim_get_stats(strip->channel, out);
+}
+
+static void run_case(const bench_group_t *group, const bench_case_t *bc, size_t length)
+{
+    led_strip_t strip = {
+        .type   = LED_STRIP_WS2812,
+        .order  = LED_ORDER_GRB,
+        .length = length,
+        .gpio   = 18,
+    };
+
+    if (bc->configure)
+        bc->configure(&strip);
+
+    led_strip_init(&strip);
+    if (!strip.buf) {
+        printf("%-12s %-22s %7zu   init failed\n", group->name, bc->name, length);
+        return;
+    }
+
+    if (bc->setup)
+        bc->setup(&strip);
+
+    uint32_t iterations = PIXEL_BUDGET / length;
+    if (iterations < MIN_ITERATIONS)
+        iterations = MIN_ITERATIONS;
+
+    /* warm caches + lazy tables */
+    bc->run(&strip);
+
+    rmt_sim_stats_t before;
+    wire_stats(&strip, &before);
+
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+        bc->run(&strip);
+    uint64_t t1 = now_ns();
+
+    rmt_sim_stats_t after;
+    wire_stats(&strip, &after);
+
+    double frame_ns = (double)(t1 - t0) / iterations;
+
+    printf("%-12s %-22s %7zu %10.2f %11.1f",
+           group->name, bc->name, length,
+           frame_ns / (double)length, frame_ns / 1000.0);
+
+    /* headroom = how many times faster than the wire we encode,
+       deadline us = time the refill ISR has before the wire underruns */
+    if (after.symbols != before.symbols)
+        printf(" %11.1f %9.0fx %8u %11.1f",
+               after.last_wire_ns / 1000.0, after.last_wire_ns / frame_ns,
+               after.last_refills, after.min_refill_ns / 1000.0);
+    else
+        printf(" %11s %10s %8s %11s", "-", "-", "-", "-");
+
+    /* isr us / load = measured refill-interrupt time per frame
+       (led_strip_bench_stats only, "-" without LED_STRIP_STATS) */
+    led_strip_rmt_load_t load;
+    if (after.symbols != before.symbols &&
+        led_strip_get_rmt_load(&strip, &load) == ESP_OK && load.measured)
+        printf(" %8u %7.1f%%\n", load.isr_us, load.isr_load_permille / 10.0);
+    else
+        printf(" %8s %8s\n", "-", "-");
+
+    if (bc->teardown)
+        bc->teardown(&strip);
+
+    led_strip_free(&strip);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = argc > 1 ? argv[1] : NULL;
+
+    printf("%-12s %-22s %7s %10s %11s %11s %10s %8s %11s %8s %8s\n",
+           "group", "case", "pixels", "ns/pixel", "cpu us/frm", "wire us/frm", "headroom",
+           "refills", "deadline us", "isr us", "isr load");
+
+    for (size_t g = 0; g < sizeof(k_groups) / sizeof(k_groups[0]); g++) {
+        const bench_group_t *group = k_groups[g];
+
+        for (size_t c = 0; c < group->count; c++) {
+            const bench_case_t *bc = &group->cases[c];
+            char full[96];
+
+            snprintf(full, sizeof(full), "%s/%s", group->name, bc->name);
+            if (filter && !strstr(full, filter))
+                continue;
+
+            for (size_t l = 0; l < sizeof(k_lengths) / sizeof(k_lengths[0]); l++)
+                run_case(group, bc, k_lengths[l]);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "led_strip.h"
+
+/*
+    HOST BENCHMARK HARNESS
+
+    Every case runs once per strip length and is
+    reported as ns per pixel of one run() call.
+*/
+
+typedef struct {
+    const char *name;
+    void (*setup)(led_strip_t *strip);      /* optional */
+    void (*run)(led_strip_t *strip);        /* one frame */
+    void (*teardown)(led_strip_t *strip);   /* optional */
+    void (*configure)(led_strip_t *strip);  /* optional, before init */
+} bench_case_t;
+
+typedef struct {
+    const char         *name;
+    const bench_case_t *cases;
+    size_t              count;
+} bench_group_t;
+
+/* Cheap per-frame color source so runs are not constant-folded */
+static inline rgb_t bench_color(size_t i)
+{
+    return (rgb_t){
+        .r = (uint8_t)(i * 7),
+        .g = (uint8_t)(i * 13),
+        .b = (uint8_t)(i * 29),
+    };
+}
+
+extern const bench_group_t bench_pipeline;
+extern const bench_group_t bench_dither;
+extern const bench_group_t bench_fx;
+extern const bench_group_t bench_layer;
+extern const bench_group_t bench_map;
+extern const bench_group_t bench_rmt;
+extern const bench_group_t bench_spi;
+extern const bench_group_t bench_queue;
+extern const bench_group_t bench_dmx;
@@ -0,0 +1,72 @@
+#include "bench.h"
+
+#include "led_strip_core.h"
+
+/*
+    16-BIT / DITHER BENCHMARKS
+
+    - stage8        : 8-bit LUT kernel only (reference)
+    - stage16       : 16-bit gain + temporal dither kernel only
+    - stage16_gamma : same with the interpolated 16-bit gamma curve
+    - set_pixels16  : whole-frame 16-bit span write
+    - encode16      : full refresh of a 16-bit strip
+*/
+
+#define FRAME_MAX 10000
+
+static rgb16_t s_frame16[FRAME_MAX];
+static uint8_t s_wire[FRAME_MAX * 3];
+
+static void configure_16(led_strip_t *strip)
+{
+    strip->linear16 = true;
+}
+
+static void setup_frame(led_strip_t *strip)
+{
+    for (size_t i = 0; i < FRAME_MAX; i++) {
+        s_frame16[i] = (rgb16_t){
+            .r = (uint16_t)(i * 97),
+            .g = (uint16_t)(i * 389),
+            .b = (uint16_t)(i * 1201),
+        };
+    }
+
+    led_strip_set_pixels16(strip, 0, s_frame16, strip->length);
+    led_strip_set_brightness(strip, 40);
+}
+
+static void setup_gamma(led_strip_t *strip)
+{
+    setup_frame(strip);
+    led_strip_enable_gamma(strip, true);
+}
+
+static void run_stage(led_strip_t *strip)
+{
+    led_strip_core_stage_pixels(strip, strip->buf, 0, strip->length, s_wire);
+}
+
+static void run_set_pixels16(led_strip_t *strip)
+{
+    led_strip_set_pixels16(strip, 0, s_frame16, strip->length);
+}
+
+static void run_encode(led_strip_t *strip)
+{
+    led_strip_refresh(strip);
+}
+
+static const bench_case_t k_cases[] = {
+    { "stage8",         setup_frame, run_stage,        NULL, NULL         },
+    { "stage16",        setup_frame, run_stage,        NULL, configure_16 },
+    { "stage16_gamma",  setup_gamma, run_stage,        NULL, configure_16 },
+    { "set_pixels16",   setup_frame, run_set_pixels16, NULL, configure_16 },
+    { "encode16",       setup_frame, run_encode,       NULL, configure_16 },
+};
+
+const bench_group_t bench_dither = {
+    .name  = "dither",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
@@ -0,0 +1,127 @@
+#include "bench.h"
+
+#include <string.h>
+
+#include "led_strip_dmx.h"
+
+/*
+    DMX-OVER-IP INGEST BENCHMARKS
+
+    One universe per 170 pixels (up to LED_DMX_MAX_MAPS,
+    longer strips cycle through the same universes so a
+    run still writes length pixels). Packets are built
+    once in setup; buffer writes only (no refresh).
+
+    - dmx_e131   : E1.31 data packets, parsed + span write
+    - dmx_artnet : ArtDmx packets, parsed + span write
+*/
+
+#define PX_PER_UNIVERSE 170
+#define E131_HDR        126
+#define ARTNET_HDR      18
+
+static uint8_t      s_packets[LED_DMX_MAX_MAPS][E131_HDR + LED_DMX_SLOTS];
+static size_t       s_len[LED_DMX_MAX_MAPS];
+static size_t       s_universes;
+static led_dmx_rx_t s_rx;
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)(v >> 16));
+    put16(p + 2, (uint16_t)v);
+}
+
+static void build_e131(uint8_t *p, uint16_t universe, const uint8_t *data, size_t slots)
+{
+    memset(p, 0, E131_HDR);
+    put16(p, 0x0010);
+    memcpy(p + 4, "ASC-E1.17", 9);
+    put32(p + 18, 0x00000004);
+    put32(p + 40, 0x00000002);
+    p[108] = 100;
+    put16(p + 113, universe);
+    p[117] = 0x02;
+    p[118] = 0xa1;
+    put16(p + 121, 1);
+    put16(p + 123, (uint16_t)(slots + 1));
+    memcpy(p + E131_HDR, data, slots);
+}
+
+static void build_artnet(uint8_t *p, uint16_t universe, const uint8_t *data, size_t slots)
+{
+    memset(p, 0, ARTNET_HDR);
+    memcpy(p, "Art-Net", 8);
+    p[8] = 0x00;
+    p[9] = 0x50;
+    p[11] = 14;
+    p[14] = (uint8_t)universe;
+    p[15] = (uint8_t)(universe >> 8);
+    put16(p + 16, (uint16_t)slots);
+    memcpy(p + ARTNET_HDR, data, slots);
+}
+
+static void setup(led_strip_t *strip, bool artnet)
+{
+    led_dmx_map_t maps[LED_DMX_MAX_MAPS];
+    uint8_t data[LED_DMX_SLOTS];
+
+    s_universes = (strip->length + PX_PER_UNIVERSE - 1) / PX_PER_UNIVERSE;
+    if (s_universes > LED_DMX_MAX_MAPS)
+        s_universes = LED_DMX_MAX_MAPS;
+
+    for (size_t u = 0; u < s_universes; u++) {
+        size_t start = u * PX_PER_UNIVERSE;
+        size_t px = strip->length - start < PX_PER_UNIVERSE ? strip->length - start : PX_PER_UNIVERSE;
+
+        for (size_t i = 0; i < px; i++) {
+            rgb_t c = bench_color(start + i);
+            memcpy(&data[i * 3], &c, sizeof(c));
+        }
+
+        maps[u] = (led_dmx_map_t){ .universe = (uint16_t)(u + 1), .strip = strip, .start = start };
+
+        if (artnet) {
+            build_artnet(s_packets[u], (uint16_t)(u + 1), data, px * 3);
+            s_len[u] = ARTNET_HDR + px * 3;
+        } else {
+            build_e131(s_packets[u], (uint16_t)(u + 1), data, px * 3);
+            s_len[u] = E131_HDR + px * 3;
+        }
+    }
+
+    led_dmx_rx_init(&s_rx, maps, s_universes, NULL);
+}
+
+static void setup_e131(led_strip_t *strip)   { setup(strip, false); }
+static void setup_artnet(led_strip_t *strip) { setup(strip, true); }
+
+static void run_ingest(led_strip_t *strip)
+{
+    static uint8_t seq;
+
+    for (size_t done = 0; done < strip->length; ) {
+        seq++;
+        for (size_t u = 0; u < s_universes && done < strip->length; u++) {
+            s_packets[u][111] = seq;    // E1.31 sequence, ignored by Art-Net
+            led_dmx_rx_ingest(&s_rx, s_packets[u], s_len[u]);
+            done += PX_PER_UNIVERSE;
+        }
+    }
+}
+
+static const bench_case_t k_cases[] = {
+    { "dmx_e131",   setup_e131,   run_ingest, NULL, NULL },
+    { "dmx_artnet", setup_artnet, run_ingest, NULL, NULL },
+};
+
+const bench_group_t bench_dmx = {
+    .name  = "dmx",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
@@ -0,0 +1,100 @@
+#include "bench.h"
+
+#include "led_strip_fx.h"
+
+/*
+    EFFECTS BENCHMARKS
+
+    One frame of each built-in effect over the whole
+    strip, render only (no refresh). Budget on an
+    ESP32-S3: < 1 ms per 1000 pixels (1000 ns/pixel).
+
+    - rainbow   : hue wheel lookup per pixel
+    - chase     : incremental block edges (2 px per block)
+    - chase_rgbw: same on an SK6812 strip (scratch row + span copy)
+    - fade      : raised-cosine crossfade, range fill
+    - twinkle   : per-pixel decay + random sparkles
+    - fire      : heat cooling / diffusion / palette
+*/
+
+static led_fx_t s_fx;
+
+static void setup_fx(led_strip_t *strip, const led_fx_config_t *cfg)
+{
+    led_fx_init(&s_fx, strip, cfg);
+    led_fx_render(strip, &s_fx);
+}
+
+static void setup_rainbow(led_strip_t *strip)
+{
+    setup_fx(strip, &(led_fx_config_t){
+        .kind = LED_FX_RAINBOW,
+        .speed = 3 << 8,
+        .rainbow.hue_step = 0x180,
+    });
+}
+
+static void setup_chase(led_strip_t *strip)
+{
+    setup_fx(strip, &(led_fx_config_t){
+        .kind = LED_FX_CHASE,
+        .speed = 1 << 8,
+        .chase = { .size = 4, .gap = 12, .on = { 255, 80, 0 }, .off = { 0, 0, 8 } },
+    });
+}
+
+static void setup_fade(led_strip_t *strip)
+{
+    setup_fx(strip, &(led_fx_config_t){
+        .kind = LED_FX_FADE,
+        .speed = 1 << 8,
+        .fade = { .from = { 0, 0, 40 }, .to = { 255, 120, 0 } },
+    });
+}
+
+static void setup_twinkle(led_strip_t *strip)
+{
+    setup_fx(strip, &(led_fx_config_t){
+        .kind = LED_FX_TWINKLE,
+        .twinkle = { .spawn = 20, .decay = 240 },
+    });
+}
+
+static void setup_fire(led_strip_t *strip)
+{
+    setup_fx(strip, &(led_fx_config_t){
+        .kind = LED_FX_FIRE,
+        .fire = { .cooling = 55, .sparking = 120 },
+    });
+}
+
+static void configure_rgbw(led_strip_t *strip)
+{
+    strip->type = LED_STRIP_SK6812;
+}
+
+static void run_fx(led_strip_t *strip)
+{
+    led_fx_render(strip, &s_fx);
+}
+
+static void teardown_fx(led_strip_t *strip)
+{
+    (void)strip;
+    led_fx_free(&s_fx);
+}
+
+static const bench_case_t k_cases[] = {
+    { "rainbow",    setup_rainbow, run_fx, teardown_fx, NULL           },
+    { "chase",      setup_chase,   run_fx, teardown_fx, NULL           },
+    { "chase_rgbw", setup_chase,   run_fx, teardown_fx, configure_rgbw },
+    { "fade",       setup_fade,    run_fx, teardown_fx, NULL           },
+    { "twinkle",    setup_twinkle, run_fx, teardown_fx, NULL           },
+    { "fire",       setup_fire,    run_fx, teardown_fx, NULL           },
+};
+
+const bench_group_t bench_fx = {
+    .name  = "fx",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
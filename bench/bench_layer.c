@@ -0,0 +1,104 @@
+#include "bench.h"
+
+#include "led_strip_layer.h"
+
+/*
+    LAYER BENCHMARKS
+
+    Two full-strip layers: an opaque base and a top
+    layer at opacity 160 in the given blend mode. The
+    top layer is marked dirty every frame, so each run
+    composites the whole strip (render only, no refresh).
+
+    - alpha / add / multiply / max : one full composite
+    - alpha_rgbw : alpha on an SK6812 strip (scratch row + span copy)
+    - status     : 16-pixel status layer changes, ambient base does not
+    - idle       : nothing changed (cost of the dirty check)
+*/
+
+static led_layer_t       s_layers[2];
+static led_layer_stack_t s_stack;
+
+static void setup_stack(led_strip_t *strip, led_blend_t mode, size_t top_start, size_t top_len)
+{
+    led_layer_init(&s_layers[0], strip, &(led_layer_config_t){
+        .mode = LED_BLEND_ALPHA, .opacity = 255,
+    });
+    led_layer_init(&s_layers[1], strip, &(led_layer_config_t){
+        .start = top_start, .length = top_len,
+        .mode = mode, .opacity = 160,
+    });
+
+    for (size_t i = 0; i < s_layers[0].cfg.length; i++)
+        s_layers[0].pixels[i] = bench_color(i);
+    for (size_t i = 0; i < s_layers[1].cfg.length; i++)
+        s_layers[1].pixels[i] = bench_color(i * 3 + 1);
+
+    led_layer_stack_init(&s_stack, strip, s_layers, 2);
+    led_layer_stack_render(strip, &s_stack);
+}
+
+static void setup_alpha(led_strip_t *strip)
+{
+    setup_stack(strip, LED_BLEND_ALPHA, 0, 0);
+}
+
+static void setup_add(led_strip_t *strip)
+{
+    setup_stack(strip, LED_BLEND_ADD, 0, 0);
+}
+
+static void setup_multiply(led_strip_t *strip)
+{
+    setup_stack(strip, LED_BLEND_MULTIPLY, 0, 0);
+}
+
+static void setup_max(led_strip_t *strip)
+{
+    setup_stack(strip, LED_BLEND_MAX, 0, 0);
+}
+
+static void setup_status(led_strip_t *strip)
+{
+    setup_stack(strip, LED_BLEND_ALPHA, strip->length / 2, 16);
+}
+
+static void configure_rgbw(led_strip_t *strip)
+{
+    strip->type = LED_STRIP_SK6812;
+}
+
+static void run_full(led_strip_t *strip)
+{
+    led_layer_mark_dirty(&s_layers[1], 0, s_layers[1].cfg.length);
+    led_layer_stack_render(strip, &s_stack);
+}
+
+static void run_idle(led_strip_t *strip)
+{
+    led_layer_stack_render(strip, &s_stack);
+}
+
+static void teardown_stack(led_strip_t *strip)
+{
+    (void)strip;
+    led_layer_stack_free(&s_stack);
+    led_layer_free(&s_layers[0]);
+    led_layer_free(&s_layers[1]);
+}
+
+static const bench_case_t k_cases[] = {
+    { "alpha",      setup_alpha,    run_full, teardown_stack, NULL           },
+    { "add",        setup_add,      run_full, teardown_stack, NULL           },
+    { "multiply",   setup_multiply, run_full, teardown_stack, NULL           },
+    { "max",        setup_max,      run_full, teardown_stack, NULL           },
+    { "alpha_rgbw", setup_alpha,    run_full, teardown_stack, configure_rgbw },
+    { "status",     setup_status,   run_full, teardown_stack, NULL           },
+    { "idle",       setup_alpha,    run_idle, teardown_stack, NULL           },
+};
+
+const bench_group_t bench_layer = {
+    .name  = "layer",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
@@ -0,0 +1,90 @@
+#include "bench.h"
+
+#include "led_strip_map.h"
+
+/*
+    SEGMENT / MATRIX BENCHMARKS
+
+    The strip as a 20-pixel-wide serpentine panel
+    (height = length / 20), or as one reversed segment.
+    Buffer writes only (no refresh).
+
+    - matrix_set_pixel : every (x, y) through the index table
+    - matrix_fill_rect : whole panel, one span fill per row
+    - matrix_blit      : whole frame, one span copy per row
+                         (odd rows reversed)
+    - segment_reverse  : reversed span write over the strip
+*/
+
+#define PANEL_W 20
+
+static rgb_t         s_frame[10000];
+static led_matrix_t  s_matrix;
+static led_segment_t s_seg;
+
+static void setup_matrix(led_strip_t *strip)
+{
+    for (size_t i = 0; i < strip->length; i++)
+        s_frame[i] = bench_color(i);
+
+    led_matrix_init(&s_matrix, strip, &(led_matrix_config_t){
+        .width  = PANEL_W,
+        .height = (uint16_t)(strip->length / PANEL_W),
+        .layout = LED_MATRIX_SERPENTINE,
+    });
+}
+
+static void setup_segment(led_strip_t *strip)
+{
+    for (size_t i = 0; i < strip->length; i++)
+        s_frame[i] = bench_color(i);
+
+    led_segment_init(&s_seg, strip, 0, 0, true);
+}
+
+static void run_set_pixel(led_strip_t *strip)
+{
+    (void)strip;
+    size_t i = 0;
+    for (uint16_t y = 0; y < s_matrix.height; y++)
+        for (uint16_t x = 0; x < s_matrix.width; x++)
+            led_matrix_set_pixel(&s_matrix, x, y, s_frame[i++]);
+}
+
+static void run_fill_rect(led_strip_t *strip)
+{
+    static uint8_t v;
+    (void)strip;
+    v++;
+    led_matrix_fill_rect(&s_matrix, 0, 0, s_matrix.width, s_matrix.height, (rgb_t){ v, 0, 255 - v });
+}
+
+static void run_blit(led_strip_t *strip)
+{
+    (void)strip;
+    led_matrix_blit(&s_matrix, 0, 0, s_frame, s_matrix.width, s_matrix.height, s_matrix.width);
+}
+
+static void run_segment(led_strip_t *strip)
+{
+    led_segment_set_pixels(&s_seg, 0, s_frame, strip->length);
+}
+
+static void teardown_matrix(led_strip_t *strip)
+{
+    (void)strip;
+    led_matrix_free(&s_matrix);
+}
+
+static const bench_case_t k_cases[] = {
+    { "matrix_set_pixel", setup_matrix,  run_set_pixel, teardown_matrix, NULL },
+    { "matrix_fill_rect", setup_matrix,  run_fill_rect, teardown_matrix, NULL },
+    { "matrix_blit",      setup_matrix,  run_blit,      teardown_matrix, NULL },
+    { "segment_reverse",  setup_segment, run_segment,   NULL,            NULL },
+};
+
+const bench_group_t bench_map = {
+    .name  = "map",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
@@ -0,0 +1,192 @@
+#include "bench.h"
+
+/*
+    PIPELINE BENCHMARKS
+
+    - set_pixel        : raw per-pixel write (no gamma, full brightness)
+    - set_pixel_scaled : per-pixel write with gamma + brightness
+    - set_pixels       : whole-frame span write
+    - set_pixels_scaled: span write with gamma + brightness
+    - fill             : whole-strip fill (pattern copy)
+    - clear            : whole-strip clear (memset)
+    - encode           : full-frame refresh (RMT encode of the frame buffer)
+    - encode_scaled    : same with gamma + brightness applied by the encoder
+    - fade             : brightness step + refresh, pixels untouched
+    - refresh_partial  : one pixel at 10% of the strip changed, then refresh
+    - rgb_to_rgbw      : span conversion of an RGB frame (no strip I/O)
+    - set_pixels_rgbw  : span write on an SK6812 (4 bytes / pixel) strip
+    - encode_rgbw      : full-frame refresh of an SK6812 strip
+    - rgb_to_hsv       : span conversion of an RGB frame (no strip I/O)
+    - set_pixels_hsv   : integer HSV span write into the strip buffer
+    - encode_power     : encode with a power budget that dims the frame
+                         (whole strip re-summed: worst case)
+    - fade_power       : fade under a power budget (no pixel changed,
+                         no re-sum)
+    - encode_pal8      : full-frame refresh of an 8-bit palette strip
+    - encode_pal4      : same with 4-bit indices (two pixels / byte)
+    - palette_cycle    : rotate all 256 palette entries + refresh,
+                         indices untouched
+*/
+
+#define FRAME_MAX 10000
+
+static rgb_t  s_frame[FRAME_MAX];
+static rgbw_t s_frame_w[FRAME_MAX];
+static hsv_t  s_frame_hsv[FRAME_MAX];
+
+static void frame_init(void)
+{
+    for (size_t i = 0; i < FRAME_MAX; i++)
+        s_frame[i] = bench_color(i);
+
+    rgb_to_rgbw_span(s_frame, s_frame_w, FRAME_MAX);
+    rgb_to_hsv_span(s_frame, s_frame_hsv, FRAME_MAX);
+}
+
+static void configure_rgbw(led_strip_t *strip)
+{
+    strip->type = LED_STRIP_SK6812;
+}
+
+static void setup_rgbw(led_strip_t *strip)
+{
+    frame_init();
+    led_strip_set_pixels_rgbw(strip, 0, s_frame_w, strip->length);
+}
+
+static void setup_plain(led_strip_t *strip)
+{
+    (void)strip;
+    frame_init();
+}
+
+static void setup_scaled(led_strip_t *strip)
+{
+    frame_init();
+    led_strip_set_brightness(strip, 128);
+    led_strip_enable_gamma(strip, true);
+}
+
+static void setup_power(led_strip_t *strip)
+{
+    frame_init();
+    led_strip_set_pixels(strip, 0, s_frame, strip->length);
+    led_strip_set_power_budget(strip, strip->length * 10);
+}
+
+static void configure_pal8(led_strip_t *strip)
+{
+    strip->palette_bits = 8;
+}
+
+static void configure_pal4(led_strip_t *strip)
+{
+    strip->palette_bits = 4;
+}
+
+static void setup_palette(led_strip_t *strip)
+{
+    frame_init();
+    led_strip_set_palette(strip, 0, s_frame, 1u << strip->palette_bits);
+
+    for (size_t i = 0; i < strip->length; i++)
+        led_strip_set_index(strip, i, (uint8_t)(i * 7));
+}
+
+static void run_set_pixel(led_strip_t *strip)
+{
+    for (size_t i = 0; i < strip->length; i++)
+        led_strip_set_pixel(strip, i, bench_color(i));
+}
+
+static void run_set_pixels(led_strip_t *strip)
+{
+    led_strip_set_pixels(strip, 0, s_frame, strip->length);
+}
+
+static void run_rgb_to_rgbw(led_strip_t *strip)
+{
+    rgb_to_rgbw_span(s_frame, s_frame_w, strip->length);
+}
+
+static void run_set_pixels_rgbw(led_strip_t *strip)
+{
+    led_strip_set_pixels_rgbw(strip, 0, s_frame_w, strip->length);
+}
+
+static void run_rgb_to_hsv(led_strip_t *strip)
+{
+    rgb_to_hsv_span(s_frame, s_frame_hsv, strip->length);
+}
+
+static void run_set_pixels_hsv(led_strip_t *strip)
+{
+    led_strip_set_pixels_hsv(strip, 0, s_frame_hsv, strip->length);
+}
+
+static void run_fill(led_strip_t *strip)
+{
+    led_strip_fill(strip, bench_color(strip->length));
+}
+
+static void run_clear(led_strip_t *strip)
+{
+    led_strip_clear(strip);
+}
+
+static void run_encode(led_strip_t *strip)
+{
+    led_strip_invalidate(strip);
+    led_strip_refresh(strip);
+}
+
+static void run_fade(led_strip_t *strip)
+{
+    led_strip_set_brightness(strip, led_strip_get_brightness(strip) + 1);
+    led_strip_refresh(strip);
+}
+
+static void run_refresh_partial(led_strip_t *strip)
+{
+    static uint8_t n;
+
+    led_strip_set_pixel(strip, strip->length / 10, bench_color(++n));
+    led_strip_refresh(strip);
+}
+
+static void run_palette_cycle(led_strip_t *strip)
+{
+    static uint8_t phase;
+
+    led_strip_set_palette(strip, 0, s_frame + ++phase, 256);
+    led_strip_refresh(strip);
+}
+
+static const bench_case_t k_cases[] = {
+    { "set_pixel",         setup_plain,  run_set_pixel,       NULL, NULL },
+    { "set_pixel_scaled",  setup_scaled, run_set_pixel,       NULL, NULL },
+    { "set_pixels",        setup_plain,  run_set_pixels,      NULL, NULL },
+    { "set_pixels_scaled", setup_scaled, run_set_pixels,      NULL, NULL },
+    { "fill",              setup_plain,  run_fill,            NULL, NULL },
+    { "clear",             setup_plain,  run_clear,           NULL, NULL },
+    { "encode",            setup_plain,  run_encode,          NULL, NULL },
+    { "encode_scaled",     setup_scaled, run_encode,          NULL, NULL },
+    { "fade",              setup_plain,  run_fade,            NULL, NULL },
+    { "refresh_partial",   setup_plain,  run_refresh_partial, NULL, NULL },
+    { "rgb_to_rgbw",       setup_plain,  run_rgb_to_rgbw,     NULL, NULL },
+    { "set_pixels_rgbw",   setup_rgbw,   run_set_pixels_rgbw, NULL, configure_rgbw },
+    { "encode_rgbw",       setup_rgbw,   run_encode,          NULL, configure_rgbw },
+    { "rgb_to_hsv",        setup_plain,  run_rgb_to_hsv,      NULL, NULL },
+    { "set_pixels_hsv",    setup_plain,  run_set_pixels_hsv,  NULL, NULL },
+    { "encode_power",      setup_power,  run_encode,          NULL, NULL },
+    { "fade_power",        setup_power,  run_fade,            NULL, NULL },
+    { "encode_pal8",       setup_palette, run_encode,         NULL, configure_pal8 },
+    { "encode_pal4",       setup_palette, run_encode,         NULL, configure_pal4 },
+    { "palette_cycle",     setup_palette, run_palette_cycle,  NULL, configure_pal8 },
+};
+
+const bench_group_t bench_pipeline = {
+    .name  = "pipeline",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
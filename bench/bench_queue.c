@@ -0,0 +1,80 @@
+#include "bench.h"
+
+#include <string.h>
+
+#include "led_strip_queue.h"
+
+/*
+    FRAME QUEUE BENCHMARKS
+
+    Producer and consumer on the same thread: one
+    claim / fill / publish, then apply. Buffer writes
+    only (no refresh).
+
+    - queue_full    : every pixel changes each frame
+    - queue_partial : a 16-pixel window moves, the rest
+                      is skipped by the head / tail compare
+    - queue_idle    : apply with nothing published
+*/
+
+static rgb_t             s_frame[10000];
+static led_frame_queue_t s_queue;
+
+static void setup_queue(led_strip_t *strip)
+{
+    for (size_t i = 0; i < strip->length; i++)
+        s_frame[i] = bench_color(i);
+
+    led_frame_queue_init(&s_queue, &strip, 1);
+}
+
+static void run_full(led_strip_t *strip)
+{
+    static uint8_t v;
+    v++;
+
+    rgb_t *slot = led_frame_queue_claim(&s_queue);
+    for (size_t i = 0; i < strip->length; i++)
+        slot[i] = (rgb_t){ (uint8_t)(s_frame[i].r + v), s_frame[i].g, s_frame[i].b };
+
+    led_frame_queue_publish(&s_queue);
+    led_frame_queue_apply(&s_queue);
+}
+
+static void run_partial(led_strip_t *strip)
+{
+    static size_t pos;
+    pos = (pos + 1) % (strip->length - 16);
+
+    rgb_t *slot = led_frame_queue_claim(&s_queue);
+    memcpy(slot, s_frame, strip->length * sizeof(rgb_t));
+    for (size_t i = pos; i < pos + 16; i++)
+        slot[i] = (rgb_t){ 255, 255, 255 };
+
+    led_frame_queue_publish(&s_queue);
+    led_frame_queue_apply(&s_queue);
+}
+
+static void run_idle(led_strip_t *strip)
+{
+    (void)strip;
+    led_frame_queue_apply(&s_queue);
+}
+
+static void teardown_queue(led_strip_t *strip)
+{
+    (void)strip;
+    led_frame_queue_free(&s_queue);
+}
+
+static const bench_case_t k_cases[] = {
+    { "queue_full",    setup_queue, run_full,    teardown_queue, NULL },
+    { "queue_partial", setup_queue, run_partial, teardown_queue, NULL },
+    { "queue_idle",    setup_queue, run_idle,    teardown_queue, NULL },
+};
+
+const bench_group_t bench_queue = {
+    .name  = "queue",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
@@ -0,0 +1,75 @@
+#include "bench.h"
+
+/*
+    RMT BENCHMARKS
+
+    Full-frame refresh with different channel resources.
+    The simulator refills symbol memory the way the
+    driver does (whole block, then one half per refill
+    interrupt), so refills / deadline us show how often
+    the refill ISR fires and how late it may run before
+    the wire underruns. isr us / isr load are the encoder
+    time measured inside those interrupts per frame
+    (led_strip_bench_stats).
+
+    - mem64      : default, one 64-symbol block
+    - mem128     : two blocks
+    - mem256     : four blocks (half of the ESP32 pool)
+    - dma1024    : DMA-backed, 1024-symbol buffer (default with DMA)
+    - dma4096    : DMA-backed, 4096-symbol buffer
+    - dma1024_rgbw : same as dma1024 on an SK6812 strip
+*/
+
+static void configure_mem128(led_strip_t *strip)
+{
+    strip->rmt.mem_block_symbols = 128;
+}
+
+static void configure_mem256(led_strip_t *strip)
+{
+    strip->rmt.mem_block_symbols = 256;
+}
+
+static void configure_dma(led_strip_t *strip)
+{
+    strip->rmt.flags.with_dma = true;
+}
+
+static void configure_dma4096(led_strip_t *strip)
+{
+    strip->rmt.flags.with_dma = true;
+    strip->rmt.mem_block_symbols = 4096;
+}
+
+static void configure_dma_rgbw(led_strip_t *strip)
+{
+    strip->type = LED_STRIP_SK6812;
+    strip->rmt.flags.with_dma = true;
+}
+
+static void setup_frame(led_strip_t *strip)
+{
+    for (size_t i = 0; i < strip->length; i++)
+        led_strip_set_pixel(strip, i, bench_color(i));
+}
+
+static void run_encode(led_strip_t *strip)
+{
+    led_strip_invalidate(strip);
+    led_strip_refresh(strip);
+}
+
+static const bench_case_t k_cases[] = {
+    { "mem64",        setup_frame, run_encode, NULL, NULL               },
+    { "mem128",       setup_frame, run_encode, NULL, configure_mem128   },
+    { "mem256",       setup_frame, run_encode, NULL, configure_mem256   },
+    { "dma1024",      setup_frame, run_encode, NULL, configure_dma      },
+    { "dma4096",      setup_frame, run_encode, NULL, configure_dma4096  },
+    { "dma1024_rgbw", setup_frame, run_encode, NULL, configure_dma_rgbw },
+};
+
+const bench_group_t bench_rmt = {
+    .name  = "rmt",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
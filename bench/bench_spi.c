@@ -0,0 +1,67 @@
+#include "bench.h"
+
+/*
+    SPI BENCHMARKS
+
+    Same frames as the pipeline group, sent through the
+    SPI backend: every refresh stages the pixels and
+    expands each wire byte to 4 SPI bytes through the
+    256-entry table, all in the calling task.
+
+    - encode        : full-frame refresh (stage + expand)
+    - encode_scaled : same with gamma + brightness
+    - encode_rgbw   : full-frame refresh of an SK6812 strip
+    - refresh_partial : one pixel at 10% of the strip changed
+*/
+
+static void configure_spi(led_strip_t *strip)
+{
+    strip->backend = LED_STRIP_BACKEND_SPI;
+    strip->spi_host = SPI2_HOST;
+}
+
+static void configure_spi_rgbw(led_strip_t *strip)
+{
+    configure_spi(strip);
+    strip->type = LED_STRIP_SK6812;
+}
+
+static void setup_frame(led_strip_t *strip)
+{
+    for (size_t i = 0; i < strip->length; i++)
+        led_strip_set_pixel(strip, i, bench_color(i));
+}
+
+static void setup_scaled(led_strip_t *strip)
+{
+    setup_frame(strip);
+    led_strip_set_brightness(strip, 128);
+    led_strip_enable_gamma(strip, true);
+}
+
+static void run_encode(led_strip_t *strip)
+{
+    led_strip_invalidate(strip);
+    led_strip_refresh(strip);
+}
+
+static void run_refresh_partial(led_strip_t *strip)
+{
+    static uint8_t n;
+
+    led_strip_set_pixel(strip, strip->length / 10, bench_color(++n));
+    led_strip_refresh(strip);
+}
+
+static const bench_case_t k_cases[] = {
+    { "encode",          setup_frame,  run_encode,          NULL, configure_spi      },
+    { "encode_scaled",   setup_scaled, run_encode,          NULL, configure_spi      },
+    { "encode_rgbw",     setup_frame,  run_encode,          NULL, configure_spi_rgbw },
+    { "refresh_partial", setup_frame,  run_refresh_partial, NULL, configure_spi      },
+};
+
+const bench_group_t bench_spi = {
+    .name  = "spi",
+    .cases = k_cases,
+    .count = sizeof(k_cases) / sizeof(k_cases[0]),
+};
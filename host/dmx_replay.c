@@ -0,0 +1,266 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "led_strip.h"
+#include "led_strip_dmx.h"
+#include "led_strip_func.h"
+#include "led_strip_group.h"
+#include "rmt_sim.h"
+
+/*
+    DMX-OVER-IP REPLAY (HOST BUILD ONLY)
+
+    Feeds E1.31 / Art-Net packets to led_dmx_rx_ingest()
+    on simulated strips, one 170-pixel strip per
+    universe, all in one group:
+
+      led_strip_dmx_replay [-u first] [-n universes] capture.pcap
+      led_strip_dmx_replay [-u first] [-n universes] -l port
+
+    - capture: UDP payloads of a pcap file (Ethernet,
+      BSD loopback, Linux cooked or raw IP captures)
+    - -l: UDP socket bound to port until 2 s without a
+      packet (e.g. a sender pointed at 127.0.0.1)
+
+    Packets without sync are refreshed right away. The
+    summary lists the receiver counters, the frames each
+    strip sent and its first pixel (wire order).
+*/
+
+#define PIXELS_PER_UNIVERSE 170
+#define MAX_PACKET          1500
+
+typedef struct {
+    led_strip_t       strips[LED_STRIP_GROUP_MAX];
+    size_t            count;
+    led_strip_group_t group;
+    led_dmx_rx_t      rx;
+} replay_t;
+
+/* =================================================
+   Receiver setup
+==================================================*/
+static int replay_init(replay_t *r, uint16_t first, size_t universes)
+{
+    led_dmx_map_t maps[LED_STRIP_GROUP_MAX];
+    led_strip_t *members[LED_STRIP_GROUP_MAX];
+
+    memset(r, 0, sizeof(*r));
+    r->count = universes;
+
+    for (size_t i = 0; i < universes; i++) {
+        r->strips[i] = (led_strip_t){
+            .type   = LED_STRIP_WS2812,
+            .order  = LED_ORDER_GRB,
+            .length = PIXELS_PER_UNIVERSE,
+            .gpio   = (gpio_num_t)(10 + i),
+        };
+
+        led_strip_init(&r->strips[i]);
+        if (!r->strips[i].buf)
+            return -1;
+
+        members[i] = &r->strips[i];
+        maps[i] = (led_dmx_map_t){
+            .universe = (uint16_t)(first + i),
+            .strip    = &r->strips[i],
+        };
+    }
+
+    if (led_strip_group_init(&r->group, members, universes) != ESP_OK)
+        return -1;
+
+    return led_dmx_rx_init(&r->rx, maps, universes, &r->group) == ESP_OK ? 0 : -1;
+}
+
+static void replay_packet(replay_t *r, const uint8_t *pkt, size_t len)
+{
+    if (led_dmx_rx_ingest(&r->rx, pkt, len) == LED_DMX_DATA)
+        led_dmx_rx_refresh(&r->rx);
+}
+
+static void replay_report(replay_t *r)
+{
+    led_strip_group_wait(&r->group, -1);
+
+    printf("packets %u  syncs %u  dropped %u\n",
+           (unsigned)r->rx.packets, (unsigned)r->rx.syncs, (unsigned)r->rx.dropped);
+
+    for (size_t i = 0; i < r->count; i++) {
+        rmt_sim_stats_t st;
+        size_t n;
+        uint8_t px[3] = { 0 };
+
+        rmt_sim_get_stats(r->strips[i].channel, &st);
+        const rmt_symbol_word_t *sym = rmt_sim_last_frame(r->strips[i].channel, &n);
+        if (sym)
+            rmt_sim_decode_bytes(sym, n, px, sizeof(px));
+
+        printf("universe %u  frames %u  pixel 0 %02x %02x %02x\n",
+               (unsigned)r->rx.maps[i].universe, (unsigned)st.frames, px[0], px[1], px[2]);
+    }
+}
+
+/* =================================================
+   pcap input
+==================================================*/
+static uint32_t rd32(const uint8_t *p, int swap)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return swap ? __builtin_bswap32(v) : v;
+}
+
+/* UDP payload of one captured frame, NULL if not UDP/IPv4 */
+static const uint8_t *udp_payload(uint32_t link, const uint8_t *p, size_t len, size_t *out_len)
+{
+    size_t off;
+
+    switch (link) {
+    case 0:   off = 4;  break;     /* BSD loopback */
+    case 1:   off = 14; break;     /* Ethernet */
+    case 101: off = 0;  break;     /* raw IP */
+    case 113: off = 16; break;     /* Linux cooked */
+    default:  return NULL;
+    }
+
+    if (link == 1 && len >= 14 && p[12] == 0x81 && p[13] == 0x00)
+        off += 4;                  /* 802.1Q tag */
+
+    if (len < off + 20 || (p[off] >> 4) != 4 || p[off + 9] != 17)
+        return NULL;
+
+    size_t ip_len = (size_t)(p[off] & 0x0f) * 4;
+    off += ip_len;
+    if (len < off + 8)
+        return NULL;
+
+    size_t udp_len = (size_t)(p[off + 4] << 8 | p[off + 5]);
+    if (udp_len < 8 || off + udp_len > len)
+        return NULL;
+
+    *out_len = udp_len - 8;
+    return p + off + 8;
+}
+
+static int replay_pcap(replay_t *r, const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    uint8_t hdr[24];
+    if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr)) {
+        fprintf(stderr, "%s: not a pcap file\n", path);
+        fclose(f);
+        return -1;
+    }
+
+    uint32_t magic = rd32(hdr, 0);
+    int swap = magic == 0xd4c3b2a1u || magic == 0x4d3cb2a1u;
+    if (!swap && magic != 0xa1b2c3d4u && magic != 0xa1b23c4du) {
+        fprintf(stderr, "%s: not a pcap file\n", path);
+        fclose(f);
+        return -1;
+    }
+
+    uint32_t link = rd32(hdr + 20, swap);
+    static uint8_t frame[65536];
+    uint8_t rec[16];
+
+    while (fread(rec, 1, sizeof(rec), f) == sizeof(rec)) {
+        uint32_t caplen = rd32(rec + 8, swap);
+        if (caplen > sizeof(frame) || fread(frame, 1, caplen, f) != caplen)
+            break;
+
+        size_t len;
+        const uint8_t *pkt = udp_payload(link, frame, caplen, &len);
+        if (pkt)
+            replay_packet(r, pkt, len);
+    }
+
+    fclose(f);
+    return 0;
+}
+
+/* =================================================
+   UDP input
+==================================================*/
+static int replay_udp(replay_t *r, uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    struct timeval idle = { .tv_sec = 2 };
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &idle, sizeof(idle)) < 0) {
+        perror("bind");
+        close(fd);
+        return -1;
+    }
+
+    uint8_t pkt[MAX_PACKET];
+    ssize_t n;
+
+    while ((n = recv(fd, pkt, sizeof(pkt), 0)) >= 0)
+        replay_packet(r, pkt, (size_t)n);
+
+    close(fd);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned first = 1;
+    unsigned universes = 1;
+    int port = -1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "u:n:l:")) != -1) {
+        switch (opt) {
+        case 'u': first = (unsigned)atoi(optarg); break;
+        case 'n': universes = (unsigned)atoi(optarg); break;
+        case 'l': port = atoi(optarg); break;
+        default:  goto usage;
+        }
+    }
+
+    if (universes == 0 || universes > LED_STRIP_GROUP_MAX || (port < 0 && optind >= argc))
+        goto usage;
+
+    static replay_t r;
+    if (replay_init(&r, (uint16_t)first, universes) != 0) {
+        fprintf(stderr, "strip / receiver init failed\n");
+        return 1;
+    }
+
+    int err = port >= 0 ? replay_udp(&r, (uint16_t)port) : replay_pcap(&r, argv[optind]);
+    if (err == 0)
+        replay_report(&r);
+
+    return err ? 1 : 0;
+
+usage:
+    fprintf(stderr, "usage: %s [-u first] [-n universes (1..%d)] capture.pcap | -l port\n",
+            argv[0], LED_STRIP_GROUP_MAX);
+    return 2;
+}
@@ -0,0 +1,140 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "freertos_sim.h"
+#include "rmt_sim.h"
+
+/*
+    HOST FREERTOS STAND-IN
+
+    Single-threaded: "blocking" means running the RMT
+    simulator forward until whatever we wait on happens
+    (or the timeout passes on the simulated clock).
+*/
+
+#define NS_PER_TICK ((uint64_t)portTICK_PERIOD_MS * 1000000ULL)
+
+static freertos_sim_task_req_t s_last_task;
+
+/* =================================================
+   Tasks / delays
+==================================================*/
+void vTaskDelay(TickType_t ticks)
+{
+    rmt_sim_advance_ns((uint64_t)ticks * NS_PER_TICK);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(rmt_sim_now_ns() / NS_PER_TICK);
+}
+
+/* No threads on the host: creation always fails (callers
+   see their own "no memory" path), run loops by hand */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn,
+                                   const char *name,
+                                   uint32_t stack_depth,
+                                   void *arg,
+                                   UBaseType_t priority,
+                                   TaskHandle_t *ret_task,
+                                   BaseType_t core_id)
+{
+    (void)fn;
+    (void)arg;
+
+    s_last_task = (freertos_sim_task_req_t){
+        .stack_depth = stack_depth,
+        .priority = priority,
+        .core_id = core_id,
+    };
+
+    fprintf(stderr, "freertos_sim: no tasks on the host (%s not started)\n", name ? name : "task");
+
+    if (ret_task)
+        *ret_task = NULL;
+    return pdFAIL;
+}
+
+void freertos_sim_last_task(freertos_sim_task_req_t *out)
+{
+    *out = s_last_task;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;
+}
+
+/* =================================================
+   Semaphores
+==================================================*/
+struct host_semaphore_t {
+    UBaseType_t count;
+    UBaseType_t max;
+};
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count,
+                                           UBaseType_t initial_count)
+{
+    SemaphoreHandle_t sem = calloc(1, sizeof(*sem));
+    if (!sem)
+        return NULL;
+
+    sem->max = max_count;
+    sem->count = initial_count;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return xSemaphoreCreateCounting(1, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    free(sem);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    if (!sem)
+        return pdFALSE;
+
+    uint64_t limit = ticks == portMAX_DELAY
+        ? UINT64_MAX
+        : rmt_sim_now_ns() + (uint64_t)ticks * NS_PER_TICK;
+
+    while (sem->count == 0) {
+        if (!rmt_sim_step(limit)) {
+            /* Nothing left that could give it */
+            if (limit != UINT64_MAX)
+                rmt_sim_advance_ns(limit - rmt_sim_now_ns());
+            return pdFALSE;
+        }
+    }
+
+    sem->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (!sem || sem->count >= sem->max)
+        return pdFALSE;
+
+    sem->count++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem,
+                                 BaseType_t *higher_prio_task_woken)
+{
+    if (higher_prio_task_woken)
+        *higher_prio_task_woken = pdFALSE;
+
+    return xSemaphoreGive(sem);
+}
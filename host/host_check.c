@@ -0,0 +1,1522 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "led_strip.h"
+#include "led_strip_core.h"
+#include "led_strip_dmx.h"
+#include "led_strip_func.h"
+#include "led_strip_group.h"
+#include "led_strip_layer.h"
+#include "led_strip_map.h"
+#include "led_strip_queue.h"
+#include "led_strip_sched.h"
+#include "led_strip_tables.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "freertos_sim.h"
+#include "rmt_sim.h"
+#include "spi_sim.h"
+
+/*
+    HOST CHECKS (HOST BUILD ONLY)
+
+    Behaviour the benchmarks do not look at, checked
+    against the simulated backend. Prints every failed
+    check, exit status = number of failures (ctest).
+*/
+
+static int s_failed;
+
+#define EXPECT(cond) do {                                           \
+        if (!(cond)) {                                              \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+            s_failed++;                                             \
+        }                                                           \
+    } while (0)
+
+static bool same(rgb_t a, rgb_t b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/* Logical RGB of pixel i (RGB or RGBW buffer) */
+static rgb_t pixel_at(const led_strip_t *strip, size_t i)
+{
+    const uint8_t *p = strip->buf + i * strip->bpp;
+    return (rgb_t){ p[0], p[1], p[2] };
+}
+
+static uint32_t frames_of(const led_strip_t *strip)
+{
+    rmt_sim_stats_t st;
+    rmt_sim_get_stats(strip->channel, &st);
+    return st.frames;
+}
+
+/* =================================================
+   Dirty tracking: only the prefix up to the last
+   changed pixel goes on the wire
+==================================================*/
+static size_t last_symbols(const led_strip_t *strip)
+{
+    size_t n;
+    rmt_sim_last_frame(strip->channel, &n);
+    return n;
+}
+
+static void check_dirty_prefix(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 100, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    led_strip_fill(&strip, (rgb_t){ 1, 2, 3 });
+    led_strip_refresh(&strip);
+
+    /* 24 data symbols per pixel, then the latch */
+    EXPECT(last_symbols(&strip) > 100 * 24);
+    size_t latch = last_symbols(&strip) - 100 * 24;
+    uint32_t frames = frames_of(&strip);
+
+    /* Mid-strip write: pixels 0..39 */
+    led_strip_set_pixel(&strip, 39, (rgb_t){ 0x40, 0x50, 0x60 });
+    EXPECT(strip.dirty_start == 39 && strip.dirty_end == 40);
+    led_strip_refresh(&strip);
+    EXPECT(last_symbols(&strip) == 40 * 24 + latch);
+    EXPECT(frames_of(&strip) == frames + 1);
+
+    size_t n;
+    uint8_t wire[40 * 3];
+    const rmt_symbol_word_t *sym = rmt_sim_last_frame(strip.channel, &n);
+    EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == sizeof(wire));
+    EXPECT(wire[0] == 2 && wire[1] == 1 && wire[2] == 3);
+    EXPECT(wire[117] == 0x50 && wire[118] == 0x40 && wire[119] == 0x60);
+
+    /* Nothing changed: nothing sent */
+    led_strip_refresh(&strip);
+    EXPECT(frames_of(&strip) == frames + 1);
+
+    /* Same value again is no change either */
+    led_strip_set_pixel(&strip, 39, (rgb_t){ 0x40, 0x50, 0x60 });
+    EXPECT(strip.dirty_end == 0);
+
+    /* Two writes: the prefix reaches the later one */
+    led_strip_set_pixel(&strip, 70, (rgb_t){ 9, 9, 9 });
+    led_strip_set_pixel(&strip, 10, (rgb_t){ 9, 9, 9 });
+    led_strip_refresh(&strip);
+    EXPECT(last_symbols(&strip) == 71 * 24 + latch);
+
+    /* fill_range: up to the end of the range */
+    led_strip_fill_range(&strip, 20, 5, (rgb_t){ 7, 7, 7 });
+    led_strip_refresh(&strip);
+    EXPECT(last_symbols(&strip) == 25 * 24 + latch);
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   16-bit dither: over 256 frames the wire bytes add
+   up to the 16-bit value (times the full-brightness
+   gain 255/256), each frame one of its two neighbours
+==================================================*/
+static void check_dither_average(void)
+{
+    static const rgb16_t k_values[] = {
+        { 0x0180, 0x8080, 0xfffe },
+        { 0x0001, 0x00ff, 0x1234 },
+    };
+    const size_t count = sizeof(k_values) / sizeof(k_values[0]);
+
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 2, .gpio = 18, .linear16 = true };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+        led_strip_set_pixel16(&strip, i, k_values[i]);
+
+    uint32_t sum[2][3] = { { 0 } };
+    bool near = true;
+
+    for (int f = 0; f < 256; f++) {
+        led_strip_refresh(&strip);
+
+        size_t n;
+        uint8_t wire[2 * 3];
+        const rmt_symbol_word_t *sym = rmt_sim_last_frame(strip.channel, &n);
+        EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == sizeof(wire));
+
+        for (size_t i = 0; i < count; i++) {
+            /* Wire order G, R, B */
+            const uint8_t got[3] = { wire[i * 3 + 1], wire[i * 3], wire[i * 3 + 2] };
+            const uint16_t v[3] = { k_values[i].r, k_values[i].g, k_values[i].b };
+
+            for (int c = 0; c < 3; c++) {
+                uint32_t scaled = (uint32_t)v[c] * 255 >> 8;
+                sum[i][c] += got[c];
+                near &= got[c] == scaled >> 8 || got[c] == (scaled >> 8) + 1;
+            }
+        }
+    }
+
+    EXPECT(near);
+    for (size_t i = 0; i < count; i++) {
+        EXPECT(sum[i][0] == (uint32_t)k_values[i].r * 255 >> 8);
+        EXPECT(sum[i][1] == (uint32_t)k_values[i].g * 255 >> 8);
+        EXPECT(sum[i][2] == (uint32_t)k_values[i].b * 255 >> 8);
+    }
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   RGBW: SK6812 frames carry the white byte after the
+   RGB bytes in the strip's order
+==================================================*/
+static void check_rgbw_wire(led_strip_order_t order, const uint8_t want[8])
+{
+    led_strip_t strip = { .type = LED_STRIP_SK6812, .order = order, .length = 3, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL && strip.is_rgbw && strip.bpp == 4);
+    if (!strip.buf)
+        return;
+
+    /* The first frame after init is the whole strip */
+    led_strip_refresh(&strip);
+
+    led_strip_set_pixel_rgbw(&strip, 0, (rgbw_t){ 0x11, 0x22, 0x33, 0x44 });
+    led_strip_set_pixel(&strip, 1, (rgb_t){ 0x55, 0x66, 0x77 });   /* W = 0 */
+    led_strip_refresh(&strip);
+
+    size_t n;
+    uint8_t wire[12];
+    const rmt_symbol_word_t *sym = rmt_sim_last_frame(strip.channel, &n);
+
+    /* 32 data symbols per pixel, pixel 2 never written */
+    EXPECT(n > 2 * 32 && n < 3 * 32);
+    EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == 8);
+    EXPECT(!memcmp(wire, want, 8));
+
+    led_strip_free(&strip);
+}
+
+static void check_rgbw(void)
+{
+    check_rgbw_wire(LED_ORDER_GRB, (const uint8_t[8]){ 0x22, 0x11, 0x33, 0x44, 0x66, 0x55, 0x77, 0 });
+    check_rgbw_wire(LED_ORDER_RGB, (const uint8_t[8]){ 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0 });
+
+    /* Span writes + RGB -> RGBW split */
+    led_strip_t strip = { .type = LED_STRIP_SK6812, .length = 4, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    const rgb_t rgb[2] = { { 100, 150, 200 }, { 9, 9, 9 } };
+    rgbw_t split[2];
+    rgb_to_rgbw_span(rgb, split, 2);
+    EXPECT(split[0].r == 0 && split[0].g == 50 && split[0].b == 100 && split[0].w == 100);
+    EXPECT(split[1].r == 0 && split[1].g == 0 && split[1].b == 0 && split[1].w == 9);
+
+    led_strip_set_pixels_rgbw(&strip, 2, split, 2);
+    led_strip_refresh(&strip);
+
+    size_t n;
+    uint8_t wire[16];
+    const rmt_symbol_word_t *sym = rmt_sim_last_frame(strip.channel, &n);
+    EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == 16);
+    EXPECT(wire[8] == 50 && wire[9] == 0 && wire[10] == 100 && wire[11] == 100);
+    EXPECT(wire[12] == 0 && wire[15] == 9);
+    led_strip_free(&strip);
+
+    /* RGB strips: W mixed in, saturating */
+    led_strip_t plain = { .type = LED_STRIP_WS2812, .length = 1, .gpio = 18 };
+    led_strip_init(&plain);
+    EXPECT(plain.buf != NULL);
+    if (!plain.buf)
+        return;
+
+    led_strip_set_pixel_rgbw(&plain, 0, (rgbw_t){ 200, 10, 0, 100 });
+    EXPECT(same(pixel_at(&plain, 0), (rgb_t){ 255, 110, 100 }));
+    led_strip_free(&plain);
+}
+
+/* =================================================
+   Matrix: serpentine index table, writes land on the
+   mapped strip pixels; reversed segments
+==================================================*/
+static uint16_t column_major(uint16_t x, uint16_t y, void *ctx)
+{
+    (void)ctx;
+    return x == 0 && y == 0 ? LED_MATRIX_UNMAPPED : (uint16_t)(x * 3 + y);
+}
+
+static void check_matrix(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 30, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    /* 5 x 4 panel from strip pixel 3 */
+    led_matrix_t m;
+    EXPECT(led_matrix_init(&m, &strip, &(led_matrix_config_t){
+        .width = 5, .height = 4, .offset = 3, .layout = LED_MATRIX_SERPENTINE,
+    }) == ESP_OK);
+
+    bool mapped = true;
+    for (uint16_t y = 0; y < 4; y++) {
+        for (uint16_t x = 0; x < 5; x++) {
+            size_t want = 3 + y * 5u + (y & 1 ? 4u - x : x);
+            mapped &= led_matrix_index(&m, x, y) == want;
+        }
+        EXPECT(m.row_step[y] == (y & 1 ? -1 : 1));
+    }
+    EXPECT(mapped);
+
+    /* Blit: every pixel lands where the table says */
+    rgb_t img[4 * 5];
+    for (int i = 0; i < 20; i++)
+        img[i] = (rgb_t){ (uint8_t)(i + 1), 0, 0 };
+    led_matrix_blit(&m, 0, 0, img, 5, 4, 5);
+
+    bool placed = true;
+    for (uint16_t y = 0; y < 4; y++)
+        for (uint16_t x = 0; x < 5; x++)
+            placed &= pixel_at(&strip, led_matrix_index(&m, x, y)).r == y * 5 + x + 1;
+    EXPECT(placed);
+    EXPECT(pixel_at(&strip, 2).r == 0 && pixel_at(&strip, 23).r == 0);
+
+    /* Clipped rectangle: x -1..1 of rows 1..2 -> (0..1, 1..2) */
+    led_matrix_fill_rect(&m, -1, 1, 3, 2, (rgb_t){ 0, 0, 9 });
+    EXPECT(pixel_at(&strip, 12).b == 9 && pixel_at(&strip, 11).b == 9);     /* (0,1) (1,1) */
+    EXPECT(pixel_at(&strip, 13).b == 9 && pixel_at(&strip, 14).b == 9);     /* (0,2) (1,2) */
+    EXPECT(pixel_at(&strip, 10).b == 0 && pixel_at(&strip, 15).b == 0);     /* (2,1) (2,2) */
+
+    /* Off the panel: ignored */
+    led_matrix_set_pixel(&m, 5, 0, (rgb_t){ 0, 7, 0 });
+    led_matrix_set_pixel(&m, 0, 4, (rgb_t){ 0, 7, 0 });
+    bool untouched = true;
+    for (size_t i = 0; i < strip.length; i++)
+        untouched &= pixel_at(&strip, i).g == 0;
+    EXPECT(untouched);
+    led_matrix_free(&m);
+
+    /* Custom layout: the callback's table, holes skipped */
+    led_strip_fill(&strip, (rgb_t){ 0, 0, 0 });
+    EXPECT(led_matrix_init(&m, &strip, &(led_matrix_config_t){
+        .width = 2, .height = 3, .layout = LED_MATRIX_CUSTOM, .map = column_major,
+    }) == ESP_OK);
+    EXPECT(led_matrix_index(&m, 0, 0) == LED_MATRIX_UNMAPPED);
+    EXPECT(led_matrix_index(&m, 1, 2) == 5);
+    led_matrix_fill_rect(&m, 0, 0, 2, 3, (rgb_t){ 5, 5, 5 });
+    EXPECT(pixel_at(&strip, 0).r == 0 && pixel_at(&strip, 1).r == 5 && pixel_at(&strip, 5).r == 5);
+    led_matrix_free(&m);
+
+    /* Reversed segment: index 0 = last pixel of the range */
+    led_segment_t seg;
+    EXPECT(led_segment_init(&seg, &strip, 10, 5, true) == ESP_OK);
+    const rgb_t span[3] = { { 1, 0, 0 }, { 2, 0, 0 }, { 3, 0, 0 } };
+    led_segment_set_pixels(&seg, 1, span, 3);
+    EXPECT(pixel_at(&strip, 13).r == 1 && pixel_at(&strip, 12).r == 2 && pixel_at(&strip, 11).r == 3);
+    EXPECT(pixel_at(&strip, 14).r == 0 && pixel_at(&strip, 10).r == 0);
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   4-bit palette: two indices per byte (even pixel in
+   the low nibble), a palette change resends the strip
+==================================================*/
+static void check_palette4(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 9, .gpio = 18, .palette_bits = 4 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    rgb_t colors[16];
+    for (int i = 0; i < 16; i++)
+        colors[i] = (rgb_t){ (uint8_t)(i * 16), (uint8_t)i, (uint8_t)(255 - i) };
+    led_strip_set_palette(&strip, 0, colors, 16);
+    led_strip_refresh(&strip);
+
+    /* Odd head, whole bytes, even tail; 0x1f keeps 4 bits */
+    const uint8_t idx[7] = { 0x1f, 2, 3, 4, 5, 6, 7 };
+    led_strip_set_indices(&strip, 1, idx, 7);
+    EXPECT(strip.buf[0] == 0xf0 && strip.buf[1] == 0x32 && strip.buf[2] == 0x54);
+    EXPECT(strip.buf[3] == 0x76 && strip.buf[4] == 0x00);
+
+    led_strip_set_index(&strip, 8, 9);
+    led_strip_fill_index(&strip, 3, 3, 0xa);     /* pixels 3, 4, 5 */
+    EXPECT(strip.buf[1] == 0xa2 && strip.buf[2] == 0xaa && strip.buf[4] == 0x09);
+
+    const uint8_t want_idx[9] = { 0, 15, 2, 10, 10, 10, 6, 7, 9 };
+    led_strip_refresh(&strip);
+
+    size_t n;
+    uint8_t wire[9 * 3];
+    const rmt_symbol_word_t *sym = rmt_sim_last_frame(strip.channel, &n);
+    EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == sizeof(wire));
+
+    bool expanded = true;
+    for (int i = 0; i < 9; i++) {
+        const rgb_t c = colors[want_idx[i]];
+        expanded &= wire[i * 3] == c.g && wire[i * 3 + 1] == c.r && wire[i * 3 + 2] == c.b;
+    }
+    EXPECT(expanded);
+
+    /* Clean: nothing goes out. New entry 10: the whole
+       strip does, pixels untouched */
+    uint32_t frames = frames_of(&strip);
+    led_strip_refresh(&strip);
+    EXPECT(frames_of(&strip) == frames);
+
+    const rgb_t green = { 0, 200, 0 };
+    led_strip_set_palette(&strip, 10, &green, 1);
+    led_strip_refresh(&strip);
+    EXPECT(frames_of(&strip) == frames + 1);
+    EXPECT(strip.buf[1] == 0xa2 && strip.buf[2] == 0xaa);
+
+    sym = rmt_sim_last_frame(strip.channel, &n);
+    EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == sizeof(wire));
+    EXPECT(wire[3 * 3] == 200 && wire[5 * 3] == 200 && wire[5 * 3 + 1] == 0);
+    EXPECT(wire[8 * 3] == colors[9].g && wire[8 * 3 + 1] == colors[9].r);
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   Color tables: temperature steps, gamma curve switch
+==================================================*/
+static bool same_gain(const led_strip_t *strip, uint16_t kelvin)
+{
+    return same(strip->color_gain,
+                led_temperature_gain[(kelvin - LED_TEMPERATURE_MIN) / LED_TEMPERATURE_STEP]);
+}
+
+static void check_color_tables(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 4, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    /* Nearest 100 K, ties up, clamped; 0 = off */
+    static const uint16_t k_kelvin[][2] = {
+        { 6549, 6500 }, { 6550, 6600 }, { 2730, 2700 },
+        { 1, 1000 }, { 999, 1000 }, { 11990, 12000 }, { 40000, 12000 },
+    };
+    for (size_t i = 0; i < sizeof(k_kelvin) / sizeof(k_kelvin[0]); i++) {
+        led_strip_set_color_temperature(&strip, k_kelvin[i][0]);
+        EXPECT(strip.temperature_k == k_kelvin[i][1]);
+        EXPECT(same_gain(&strip, k_kelvin[i][1]));
+    }
+
+    led_strip_set_color_temperature(&strip, 0);
+    EXPECT(strip.temperature_k == 0);
+    EXPECT(same(strip.color_gain, (rgb_t){ 255, 255, 255 }));
+
+    /* Warm white leans red, cold white blue */
+    led_strip_set_color_temperature(&strip, 2000);
+    EXPECT(strip.color_gain.r == 255 && strip.color_gain.b < strip.color_gain.g);
+    EXPECT(strip.lut[0][200] > strip.lut[2][200]);
+    led_strip_set_color_temperature(&strip, 12000);
+    EXPECT(strip.color_gain.b == 255 && strip.color_gain.r < strip.color_gain.b);
+    led_strip_set_color_temperature(&strip, 0);
+
+    /* Curve switch: the LUT follows the selected table */
+    led_strip_enable_gamma(&strip, true);
+    EXPECT(strip.lut[1][128] == led_gamma8[LED_GAMMA_2_2][128]);
+    EXPECT(led_gamma8[LED_GAMMA_2_8][128] < led_gamma8[LED_GAMMA_2_2][128]);
+
+    led_strip_fill(&strip, (rgb_t){ 128, 128, 128 });
+    led_strip_refresh(&strip);
+    uint32_t frames = frames_of(&strip);
+
+    led_strip_set_gamma_curve(&strip, LED_GAMMA_2_8);
+    EXPECT(strip.lut[1][128] == led_gamma8[LED_GAMMA_2_8][128]);
+    EXPECT(strip.gamma16 == led_gamma16[LED_GAMMA_2_8]);
+
+    /* Every pixel changes on the wire: resent */
+    led_strip_refresh(&strip);
+    EXPECT(frames_of(&strip) == frames + 1);
+
+    size_t n;
+    uint8_t wire[4 * 3];
+    const rmt_symbol_word_t *sym = rmt_sim_last_frame(strip.channel, &n);
+    EXPECT(rmt_sim_decode_bytes(sym, n, wire, sizeof(wire)) == sizeof(wire));
+    EXPECT(wire[0] == led_gamma8[LED_GAMMA_2_8][128] && wire[11] == led_gamma8[LED_GAMMA_2_8][128]);
+
+    /* Gamma off: the curve is remembered, LUT is identity */
+    led_strip_enable_gamma(&strip, false);
+    EXPECT(strip.lut[1][128] == 128 && strip.gamma16 == NULL);
+    led_strip_set_gamma_curve(&strip, LED_GAMMA_SRGB);
+    EXPECT(strip.lut[1][128] == 128);
+    led_strip_enable_gamma(&strip, true);
+    EXPECT(strip.lut[1][128] == led_gamma8[LED_GAMMA_SRGB][128]);
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   Layers: pixels no layer covers stay untouched
+==================================================*/
+static void check_layer_gaps(led_strip_type_t type)
+{
+    const rgb_t app = { 1, 2, 3 };
+    const rgb_t red = { 200, 0, 0 };
+    const rgb_t blue = { 0, 0, 200 };
+
+    led_strip_t strip = { .type = type, .length = 100, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    /* [0, 10) and [50, 60), plus [20, 30) + [30, 40) touching */
+    static const size_t k_ranges[][2] = { { 0, 10 }, { 50, 10 }, { 20, 10 }, { 30, 10 } };
+    led_layer_t layers[4];
+
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT(led_layer_init(&layers[i], &strip, &(led_layer_config_t){
+            .start = k_ranges[i][0], .length = k_ranges[i][1],
+            .mode = LED_BLEND_ALPHA, .opacity = 255,
+        }) == ESP_OK);
+        led_layer_fill(&layers[i], 0, k_ranges[i][1], i & 1 ? blue : red);
+    }
+
+    led_layer_stack_t stack;
+    EXPECT(led_layer_stack_init(&stack, &strip, layers, 4) == ESP_OK);
+
+    led_strip_fill(&strip, app);
+    led_layer_stack_render(&strip, &stack);
+
+    for (size_t i = 0; i < 100; i++) {
+        rgb_t want = app;
+        if (i < 10 || (i >= 20 && i < 30))
+            want = red;
+        else if ((i >= 30 && i < 40) || (i >= 50 && i < 60))
+            want = blue;
+
+        if (!same(pixel_at(&strip, i), want)) {
+            printf("layer gaps (type %d): pixel %zu\n", (int)type, i);
+            s_failed++;
+            break;
+        }
+    }
+
+    /* Only the outer layers change: the gap is still the app's */
+    led_layer_set_pixel(&layers[0], 0, blue);
+    led_layer_set_pixel(&layers[1], 9, red);
+    led_layer_stack_render(&strip, &stack);
+
+    EXPECT(same(pixel_at(&strip, 0), blue));
+    EXPECT(same(pixel_at(&strip, 59), red));
+    EXPECT(same(pixel_at(&strip, 15), app));
+    EXPECT(same(pixel_at(&strip, 45), app));
+
+    led_layer_stack_free(&stack);
+    for (size_t i = 0; i < 4; i++)
+        led_layer_free(&layers[i]);
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   Scheduler: late / dropped / fps accounting on the
+   simulated clock (render burns time with vTaskDelay)
+==================================================*/
+typedef struct {
+    led_strip_t *strip;
+    uint32_t     renders;
+    uint32_t     render_ms;     /* every render */
+    uint32_t     overrun_at;    /* this render takes overrun_ms, 0 = none */
+    uint32_t     overrun_ms;
+} sched_ctx_t;
+
+static void burn_render(uint32_t frame, int64_t time_us, void *arg)
+{
+    sched_ctx_t *c = arg;
+    (void)time_us;
+
+    c->renders++;
+    led_strip_set_pixel(c->strip, 0, (rgb_t){ (uint8_t)frame, 0, 0 });
+
+    uint32_t ms = c->overrun_at && c->renders == c->overrun_at ? c->overrun_ms : c->render_ms;
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+static led_strip_sched_stats_t run_sched(led_strip_sched_policy_t policy, sched_ctx_t ctx, uint32_t steps)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 100, .gpio = 18, .buffer_count = 2 };
+    led_strip_sched_stats_t st = { 0 };
+
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return st;
+
+    ctx.strip = &strip;
+
+    led_strip_sched_t sched;
+    EXPECT(led_strip_sched_init(&sched, &(led_strip_sched_config_t){
+        .strip = &strip, .fps = 100, .policy = policy,
+        .render = burn_render, .ctx = &ctx,
+    }) == ESP_OK);
+
+    for (uint32_t i = 0; i < steps; i++)
+        EXPECT(led_strip_sched_step(&sched) == ESP_OK);
+
+    led_strip_sched_get_stats(&sched, &st);
+    led_strip_free(&strip);
+    return st;
+}
+
+/* fps_milli within 2 % of want */
+static bool fps_near(uint32_t fps_milli, uint32_t want)
+{
+    return fps_milli * 50u >= want * 49u && fps_milli * 50u <= want * 51u;
+}
+
+static void check_sched(void)
+{
+    for (int p = LED_STRIP_SCHED_SKIP; p <= LED_STRIP_SCHED_COALESCE; p++) {
+        led_strip_sched_policy_t policy = (led_strip_sched_policy_t)p;
+        led_strip_sched_stats_t st;
+
+        /* 2 ms renders at 100 fps: never late */
+        st = run_sched(policy, (sched_ctx_t){ .render_ms = 2 }, 300);
+        EXPECT(st.frames == 300);
+        EXPECT(st.late == 0);
+        EXPECT(st.dropped == 0);
+        EXPECT(fps_near(st.fps_milli, 100000));
+
+        /* One 25 ms render: 15 ms late. SKIP waits for the
+           slot after next (2 dropped), COALESCE sends at once
+           and restarts the grid (1 slot merged) */
+        st = run_sched(policy, (sched_ctx_t){ .render_ms = 2, .overrun_at = 20, .overrun_ms = 25 }, 300);
+        EXPECT(st.frames == 300);
+        EXPECT(st.late == 1);
+        EXPECT(st.dropped == (policy == LED_STRIP_SCHED_SKIP ? 2u : 1u));
+        EXPECT(st.max_render_us >= 25000);
+        EXPECT(fps_near(st.fps_milli, 100000));
+
+        /* Every render 15 ms: SKIP shows every other slot
+           (50 fps), COALESCE one frame per render (66.7 fps) */
+        st = run_sched(policy, (sched_ctx_t){ .render_ms = 15 }, 300);
+        EXPECT(st.frames == 300);
+        EXPECT(st.late == 299);
+        if (policy == LED_STRIP_SCHED_SKIP) {
+            EXPECT(st.dropped == 299);
+            EXPECT(fps_near(st.fps_milli, 50000));
+        } else {
+            EXPECT(st.dropped == 0);
+            EXPECT(fps_near(st.fps_milli, 66667));
+        }
+    }
+
+    /* No tasks on the host: start reports it, nothing leaks */
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 10, .gpio = 18 };
+    led_strip_init(&strip);
+
+    sched_ctx_t ctx = { .strip = &strip };
+    led_strip_sched_t sched;
+    led_strip_sched_init(&sched, &(led_strip_sched_config_t){
+        .strip = &strip, .fps = 50, .render = burn_render, .ctx = &ctx,
+    });
+    EXPECT(led_strip_sched_start(&sched) == ESP_ERR_NO_MEM);
+    EXPECT(sched.task == NULL && sched.stopped == NULL);
+
+    /* Zeroed task settings: defaults, no core affinity */
+    freertos_sim_task_req_t req;
+    freertos_sim_last_task(&req);
+    EXPECT(req.core_id == tskNO_AFFINITY);
+    EXPECT(req.priority == 5 && req.stack_depth == 4096);
+
+    /* core_id only counts with pin_core */
+    sched.cfg.core_id = 1;
+    EXPECT(led_strip_sched_start(&sched) == ESP_ERR_NO_MEM);
+    freertos_sim_last_task(&req);
+    EXPECT(req.core_id == tskNO_AFFINITY);
+
+    sched.cfg.pin_core = true;
+    EXPECT(led_strip_sched_start(&sched) == ESP_ERR_NO_MEM);
+    freertos_sim_last_task(&req);
+    EXPECT(req.core_id == 1);
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   Groups: linear16 members resend every refresh
+==================================================*/
+static void check_group_linear16(void)
+{
+    led_strip_t dith = { .type = LED_STRIP_WS2812, .length = 30, .gpio = 18, .linear16 = true };
+    led_strip_t plain = { .type = LED_STRIP_WS2812, .length = 30, .gpio = 19 };
+
+    led_strip_init(&dith);
+    led_strip_init(&plain);
+    EXPECT(dith.buf && plain.buf);
+    if (!dith.buf || !plain.buf)
+        return;
+
+    led_strip_t *members[] = { &dith, &plain };
+    led_strip_group_t group;
+    EXPECT(led_strip_group_init(&group, members, 2) == ESP_OK);
+
+    led_strip_set_pixel16(&dith, 0, (rgb16_t){ 0x0180, 0, 0 });
+    led_strip_group_refresh(&group);
+    uint32_t f0 = frames_of(&dith);
+
+    /* Nothing written: the dithered member still goes out */
+    for (int i = 0; i < 4; i++)
+        led_strip_group_refresh(&group);
+
+    EXPECT(frames_of(&dith) == f0 + 4);
+
+    led_strip_group_free(&group);
+    led_strip_free(&dith);
+    led_strip_free(&plain);
+}
+
+/* =================================================
+   Groups: back-to-back synced rounds
+==================================================*/
+static void check_group_rounds(void)
+{
+    led_strip_t a = { .type = LED_STRIP_WS2812, .length = 60, .gpio = 18, .buffer_count = 2 };
+    led_strip_t b = { .type = LED_STRIP_WS2812, .length = 90, .gpio = 19, .buffer_count = 2 };
+
+    led_strip_init(&a);
+    led_strip_init(&b);
+    EXPECT(a.buf && b.buf);
+    if (!a.buf || !b.buf)
+        return;
+
+    led_strip_t *members[] = { &a, &b };
+    led_strip_group_t group;
+    EXPECT(led_strip_group_init(&group, members, 2) == ESP_OK);
+
+    uint32_t fa = frames_of(&a);
+    uint32_t fb = frames_of(&b);
+
+    /* No wait in between: each round waits for the last */
+    for (int i = 0; i < 3; i++) {
+        led_strip_set_pixel(&a, 0, (rgb_t){ (uint8_t)i, 0, 0 });
+        led_strip_set_pixel(&b, 0, (rgb_t){ 0, (uint8_t)i, 0 });
+        led_strip_group_refresh_async(&group);
+    }
+
+    EXPECT(led_strip_group_wait(&group, -1));
+    EXPECT(frames_of(&a) == fa + 3);
+    EXPECT(frames_of(&b) == fb + 3);
+
+    /* Never re-armed while a member was still sending */
+    rmt_sim_stats_t sa, sb;
+    rmt_sim_get_stats(a.channel, &sa);
+    rmt_sim_get_stats(b.channel, &sb);
+    EXPECT(sa.busy_sync_resets == 0 && sb.busy_sync_resets == 0);
+
+    led_strip_group_free(&group);
+    led_strip_free(&a);
+    led_strip_free(&b);
+}
+
+/* =================================================
+   Groups: a member that cannot submit aborts the
+   round instead of leaving the others armed
+==================================================*/
+static void check_group_abort(void)
+{
+    led_strip_t a = { .type = LED_STRIP_WS2812, .length = 60, .gpio = 18, .buffer_count = 2 };
+    led_strip_t b = { .type = LED_STRIP_WS2812, .length = 60, .gpio = 19 };
+
+    led_strip_init(&a);
+    led_strip_init(&b);
+    EXPECT(a.buf && b.buf);
+    if (!a.buf || !b.buf)
+        return;
+
+    led_strip_t *members[] = { &a, &b };
+    led_strip_group_t group;
+    EXPECT(led_strip_group_init(&group, members, 2) == ESP_OK);
+    EXPECT(led_strip_group_refresh(&group) == ESP_OK);
+
+    uint32_t fa = frames_of(&a);
+
+    /* b's channel is off: its submit fails after a is armed */
+    rmt_disable(b.channel);
+    led_strip_set_pixel(&a, 5, (rgb_t){ 1, 2, 3 });
+    EXPECT(led_strip_group_refresh_async(&group) == ESP_ERR_INVALID_STATE);
+
+    /* Nothing left waiting on the sync manager */
+    EXPECT(led_strip_group_wait(&group, -1));
+    EXPECT(a.tx_submitted == a.tx_done);
+    EXPECT(a.dirty_start == 0 && a.dirty_end == a.length);
+    EXPECT(frames_of(&a) == fa);
+
+    /* Back to normal: buffers handed back, both go out */
+    rmt_enable(b.channel);
+    for (int i = 0; i < 3; i++) {
+        led_strip_set_pixel(&b, 0, (rgb_t){ (uint8_t)i, 0, 0 });
+        EXPECT(led_strip_group_refresh(&group) == ESP_OK);
+    }
+    EXPECT(frames_of(&a) == fa + 3);
+
+    led_strip_group_free(&group);
+    led_strip_free(&a);
+    led_strip_free(&b);
+}
+
+/* =================================================
+   Groups: one timeout for the whole group
+==================================================*/
+static void check_group_wait_deadline(void)
+{
+    led_strip_t strips[3];
+    led_strip_t *members[3];
+
+    for (int i = 0; i < 3; i++) {
+        /* ~90 ms on the wire each */
+        strips[i] = (led_strip_t){ .type = LED_STRIP_WS2812, .length = 3000, .gpio = 18 + i };
+        led_strip_init(&strips[i]);
+        EXPECT(strips[i].buf != NULL);
+        if (!strips[i].buf)
+            return;
+        members[i] = &strips[i];
+    }
+
+    led_strip_group_t group;
+    EXPECT(led_strip_group_init(&group, members, 3) == ESP_OK);
+
+    for (int i = 0; i < 3; i++)
+        led_strip_fill(&strips[i], (rgb_t){ 7, 7, 7 });
+    EXPECT(led_strip_group_refresh_async(&group) == ESP_OK);
+
+    int64_t t0 = esp_timer_get_time();
+    EXPECT(!led_strip_group_wait(&group, 10));
+    EXPECT(esp_timer_get_time() - t0 <= 10000);
+
+    EXPECT(led_strip_group_wait(&group, -1));
+
+    led_strip_group_free(&group);
+    for (int i = 0; i < 3; i++)
+        led_strip_free(&strips[i]);
+}
+
+/* =================================================
+   Done callback: only swapped while the strip is idle
+==================================================*/
+static bool count_done(led_strip_t *strip, void *ctx)
+{
+    (void)strip;
+    (*(uint32_t *)ctx)++;
+    return false;
+}
+
+static void check_done_callback(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 50, .gpio = 18, .buffer_count = 2 };
+    uint32_t first = 0;
+    uint32_t second = 0;
+
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    EXPECT(led_strip_set_done_callback(&strip, count_done, &first) == ESP_OK);
+
+    led_strip_fill(&strip, (rgb_t){ 9, 9, 9 });
+    led_strip_refresh_async(&strip);
+
+    /* In flight: the old pair stays */
+    EXPECT(led_strip_set_done_callback(&strip, count_done, &second) == ESP_ERR_INVALID_STATE);
+
+    EXPECT(led_strip_core_wait(&strip, -1) == ESP_OK);
+    EXPECT(first == 1 && second == 0);
+
+    EXPECT(led_strip_set_done_callback(&strip, count_done, &second) == ESP_OK);
+    led_strip_refresh(&strip);      /* clean: nothing sent */
+    led_strip_invalidate(&strip);
+    led_strip_refresh(&strip);
+    EXPECT(first == 1 && second == 1);
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   DMX-over-IP: handcrafted packets
+==================================================*/
+#define E131_HDR   126
+#define ARTNET_HDR 18
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)(v >> 16));
+    put16(p + 2, (uint16_t)v);
+}
+
+/* Data packet, returns its length */
+static size_t e131_data(uint8_t *p, uint16_t universe, uint8_t seq, uint16_t sync,
+                        const uint8_t *data, size_t slots)
+{
+    memset(p, 0, E131_HDR);
+    put16(p, 0x0010);
+    memcpy(p + 4, "ASC-E1.17", 9);
+    put32(p + 18, 0x00000004);
+    put32(p + 40, 0x00000002);
+    p[108] = 100;
+    put16(p + 109, sync);
+    p[111] = seq;
+    put16(p + 113, universe);
+    p[117] = 0x02;
+    p[118] = 0xa1;
+    put16(p + 121, 1);
+    put16(p + 123, (uint16_t)(slots + 1));
+    memcpy(p + E131_HDR, data, slots);
+    return E131_HDR + slots;
+}
+
+static size_t e131_sync(uint8_t *p, uint16_t universe, uint8_t seq)
+{
+    memset(p, 0, 49);
+    put16(p, 0x0010);
+    memcpy(p + 4, "ASC-E1.17", 9);
+    put32(p + 18, 0x00000008);
+    put32(p + 40, 0x00000001);
+    p[44] = seq;
+    put16(p + 45, universe);
+    return 49;
+}
+
+static size_t artnet_dmx(uint8_t *p, uint16_t universe, const uint8_t *data, size_t slots)
+{
+    memset(p, 0, ARTNET_HDR);
+    memcpy(p, "Art-Net", 8);
+    p[9] = 0x50;
+    p[11] = 14;
+    p[14] = (uint8_t)universe;
+    p[15] = (uint8_t)(universe >> 8);
+    put16(p + 16, (uint16_t)slots);
+    memcpy(p + ARTNET_HDR, data, slots);
+    return ARTNET_HDR + slots;
+}
+
+static size_t artnet_sync(uint8_t *p)
+{
+    memset(p, 0, 14);
+    memcpy(p, "Art-Net", 8);
+    p[9] = 0x52;
+    p[11] = 14;
+    return 14;
+}
+
+/* ArtSync latches only while it keeps coming */
+static void check_dmx_artnet_sync(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 10, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    led_dmx_rx_t rx;
+    const led_dmx_map_t map = { .universe = 1, .strip = &strip };
+    EXPECT(led_dmx_rx_init(&rx, &map, 1, NULL) == ESP_OK);
+
+    uint8_t pkt[ARTNET_HDR + LED_DMX_SLOTS];
+    const uint8_t rgb[3] = { 1, 2, 3 };
+    size_t len = artnet_dmx(pkt, 1, rgb, 3);
+
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+
+    uint8_t sync[14];
+    EXPECT(led_dmx_rx_ingest(&rx, sync, artnet_sync(sync)) == LED_DMX_SYNC);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA_SYNCED);
+
+    /* Still syncing just inside the window */
+    rmt_sim_advance_ns((uint64_t)(LED_DMX_ARTNET_SYNC_MS - 1) * 1000000);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA_SYNCED);
+
+    /* Sender stopped syncing: immediate again */
+    rmt_sim_advance_ns(2 * 1000000);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+
+    /* And back when it resumes */
+    EXPECT(led_dmx_rx_ingest(&rx, sync, artnet_sync(sync)) == LED_DMX_SYNC);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA_SYNCED);
+
+    led_strip_free(&strip);
+}
+
+static rgb_t rgb_at(const uint8_t *slots)
+{
+    return (rgb_t){ slots[0], slots[1], slots[2] };
+}
+
+/* E1.31: sequence, options and length checks */
+static void check_dmx_e131_filters(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 20, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    led_dmx_rx_t rx;
+    const led_dmx_map_t map = { .universe = 1, .strip = &strip };
+    EXPECT(led_dmx_rx_init(&rx, &map, 1, NULL) == ESP_OK);
+
+    static uint8_t pkt[E131_HDR + LED_DMX_SLOTS + 8];
+    uint8_t data[6] = { 10, 20, 30, 40, 50, 60 };
+    size_t len;
+
+    len = e131_data(pkt, 1, 100, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    EXPECT(same(pixel_at(&strip, 1), rgb_at(&data[3])));
+
+    /* Repeated and older sequence numbers are stale */
+    data[0] = 99;
+    len = e131_data(pkt, 1, 100, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_IGNORED);
+    len = e131_data(pkt, 1, 95, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_IGNORED);
+    EXPECT(rx.dropped == 2 && rx.packets == 1);
+    EXPECT(pixel_at(&strip, 0).r == 10);
+
+    /* Newer (across the wrap) is taken, as is far behind
+       (sender restarted) */
+    len = e131_data(pkt, 1, 101, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    EXPECT(pixel_at(&strip, 0).r == 99);
+    len = e131_data(pkt, 1, 50, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    len = e131_data(pkt, 1, 255, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    len = e131_data(pkt, 1, 3, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    EXPECT(rx.packets == 5 && rx.dropped == 2);
+
+    /* Preview and stream-terminated data are dropped */
+    data[0] = 7;
+    len = e131_data(pkt, 1, 4, 0, data, 6);
+    pkt[112] = 0x80;
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_IGNORED);
+    len = e131_data(pkt, 1, 5, 0, data, 6);
+    pkt[112] = 0x40;
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_IGNORED);
+    EXPECT(rx.dropped == 4);
+    EXPECT(pixel_at(&strip, 0).r == 99);
+
+    /* Property count past the packet, past 512 slots or 0 */
+    uint32_t packets = rx.packets;
+    len = e131_data(pkt, 1, 6, 0, data, 6);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len - 1) == LED_DMX_IGNORED);
+    put16(pkt + 123, LED_DMX_SLOTS + 2);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, E131_HDR + LED_DMX_SLOTS + 1) == LED_DMX_IGNORED);
+    put16(pkt + 123, 0);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_IGNORED);
+    EXPECT(rx.packets == packets);
+    EXPECT(pixel_at(&strip, 0).r == 99);
+
+    /* A whole universe is fine, and clipped to the strip */
+    uint8_t full[LED_DMX_SLOTS];
+    memset(full, 0x33, sizeof(full));
+    len = e131_data(pkt, 1, 7, 0, full, LED_DMX_SLOTS);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    EXPECT(same(pixel_at(&strip, 19), (rgb_t){ 0x33, 0x33, 0x33 }));
+
+    led_strip_free(&strip);
+}
+
+/* Art-Net: length checks, 15-bit port address */
+static void check_dmx_artnet_filters(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 20, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    /* Net 1, Sub-Net 2, Universe 3 */
+    const uint16_t port = 1 << 8 | 2 << 4 | 3;
+
+    led_dmx_rx_t rx;
+    const led_dmx_map_t map = { .universe = port, .strip = &strip, .slot = 3, .start = 2 };
+    EXPECT(led_dmx_rx_init(&rx, &map, 1, NULL) == ESP_OK);
+
+    static uint8_t pkt[ARTNET_HDR + LED_DMX_SLOTS + 8];
+    const uint8_t data[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    size_t len;
+
+    /* Slot 3 on pixel 2 */
+    len = artnet_dmx(pkt, port, data, 9);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA);
+    EXPECT(same(pixel_at(&strip, 2), rgb_at(&data[3])));
+    EXPECT(same(pixel_at(&strip, 3), rgb_at(&data[6])));
+    EXPECT(same(pixel_at(&strip, 1), (rgb_t){ 0, 0, 0 }));
+
+    /* Other universe: not for us */
+    len = artnet_dmx(pkt, port + 1, data, 9);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_IGNORED);
+
+    /* Length past the packet or past 512 slots */
+    len = artnet_dmx(pkt, port, data, 9);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len - 1) == LED_DMX_IGNORED);
+    put16(pkt + 16, LED_DMX_SLOTS + 2);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, ARTNET_HDR + LED_DMX_SLOTS + 2) == LED_DMX_IGNORED);
+    EXPECT(rx.packets == 1);
+
+    led_strip_free(&strip);
+}
+
+/* Sync: only for sync_universe, refreshes exactly the
+   strips written since the last refresh */
+static void check_dmx_sync(void)
+{
+    led_strip_t strips[3];
+    led_dmx_map_t maps[3];
+
+    for (int i = 0; i < 3; i++) {
+        strips[i] = (led_strip_t){ .type = LED_STRIP_WS2812, .length = 10, .gpio = 18 + i };
+        led_strip_init(&strips[i]);
+        EXPECT(strips[i].buf != NULL);
+        if (!strips[i].buf)
+            return;
+        maps[i] = (led_dmx_map_t){ .universe = (uint16_t)(i + 1), .strip = &strips[i] };
+    }
+
+    led_dmx_rx_t rx;
+    EXPECT(led_dmx_rx_init(&rx, maps, 3, NULL) == ESP_OK);
+    rx.sync_universe = 7;
+
+    uint32_t f[3];
+    for (int i = 0; i < 3; i++)
+        f[i] = frames_of(&strips[i]);
+
+    static uint8_t pkt[E131_HDR + LED_DMX_SLOTS];
+    const uint8_t data[3] = { 0x11, 0x22, 0x33 };
+    size_t len;
+
+    /* Universes 1 and 3 written, held for sync 7 */
+    len = e131_data(pkt, 1, 1, 7, data, 3);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA_SYNCED);
+    len = e131_data(pkt, 3, 1, 7, data, 3);
+    EXPECT(led_dmx_rx_ingest(&rx, pkt, len) == LED_DMX_DATA_SYNCED);
+    EXPECT(rx.pending == 0x5);
+
+    /* Someone else's sync address: nothing happens */
+    uint8_t sync[49];
+    EXPECT(led_dmx_rx_ingest(&rx, sync, e131_sync(sync, 8, 1)) == LED_DMX_IGNORED);
+    EXPECT(rx.pending == 0x5 && rx.syncs == 0);
+
+    /* Ours: universes 1 and 3 go out, 2 does not */
+    EXPECT(led_dmx_rx_ingest(&rx, sync, e131_sync(sync, 7, 2)) == LED_DMX_SYNC);
+    EXPECT(rx.pending == 0 && rx.syncs == 1);
+
+    for (int i = 0; i < 3; i++)
+        led_strip_core_wait(&strips[i], -1);
+    EXPECT(frames_of(&strips[0]) == f[0] + 1);
+    EXPECT(frames_of(&strips[1]) == f[1]);
+    EXPECT(frames_of(&strips[2]) == f[2] + 1);
+
+    /* On the wire: pixel 0 in GRB */
+    size_t n;
+    uint8_t wire[3] = { 0 };
+    const rmt_symbol_word_t *sym = rmt_sim_last_frame(strips[2].channel, &n);
+    EXPECT(sym && rmt_sim_decode_bytes(sym, n, wire, 3) == 3);
+    EXPECT(wire[0] == 0x22 && wire[1] == 0x11 && wire[2] == 0x33);
+
+    /* A second sync with nothing new sends nothing */
+    EXPECT(led_dmx_rx_ingest(&rx, sync, e131_sync(sync, 7, 3)) == LED_DMX_SYNC);
+    for (int i = 0; i < 3; i++)
+        led_strip_core_wait(&strips[i], -1);
+    EXPECT(frames_of(&strips[0]) == f[0] + 1);
+    EXPECT(frames_of(&strips[2]) == f[2] + 1);
+
+    for (int i = 0; i < 3; i++)
+        led_strip_free(&strips[i]);
+}
+
+/* =================================================
+   Frame queue: newest frame wins, apply sends the
+   change only where the buffer allows comparing
+==================================================*/
+static void fill_frame(rgb_t *frame, size_t length, uint32_t seq)
+{
+    for (size_t i = 0; i < length; i++)
+        frame[i] = (rgb_t){ (uint8_t)seq, (uint8_t)(seq >> 8), (uint8_t)(seq >> 16) };
+}
+
+static uint32_t frame_seq(const rgb_t *frame)
+{
+    return frame[0].r | (uint32_t)frame[0].g << 8 | (uint32_t)frame[0].b << 16;
+}
+
+static void check_queue_handover(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 16, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    led_strip_t *strips[] = { &strip };
+    led_frame_queue_t q;
+    EXPECT(led_frame_queue_init(&q, strips, 1) == ESP_OK);
+
+    /* Nothing published yet */
+    EXPECT(led_frame_queue_take(&q) == NULL);
+    EXPECT(!led_frame_queue_apply(&q));
+
+    fill_frame(led_frame_queue_claim(&q), q.length, 1);
+    led_frame_queue_publish(&q);
+    fill_frame(led_frame_queue_claim(&q), q.length, 2);
+    led_frame_queue_publish(&q);
+
+    /* The second replaced the first */
+    const rgb_t *frame = led_frame_queue_take(&q);
+    EXPECT(frame && frame_seq(frame) == 2);
+    EXPECT(q.published == 2 && q.dropped == 1 && q.taken == 1);
+
+    /* Taken once only */
+    EXPECT(led_frame_queue_take(&q) == NULL);
+
+    /* The producer never gets the slot being read */
+    rgb_t *slot = led_frame_queue_claim(&q);
+    EXPECT(slot != frame);
+    fill_frame(slot, q.length, 3);
+    led_frame_queue_publish(&q);
+    EXPECT(frame_seq(frame) == 2);
+
+    frame = led_frame_queue_take(&q);
+    EXPECT(frame && frame_seq(frame) == 3);
+    EXPECT(q.dropped == 1 && q.taken == 2);
+
+    led_frame_queue_free(&q);
+    led_strip_free(&strip);
+}
+
+/* Dirty range after applying base with [lo, hi) changed */
+static void apply_change(led_frame_queue_t *q, led_strip_t *strip, size_t lo, size_t hi)
+{
+    rgb_t *slot = led_frame_queue_claim(q);
+    for (size_t i = 0; i < q->length; i++)
+        slot[i] = (rgb_t){ (uint8_t)i, 1, 2 };
+    led_frame_queue_publish(q);
+    EXPECT(led_frame_queue_apply(q));
+    led_strip_refresh(strip);
+    EXPECT(strip->dirty_end == 0);
+
+    slot = led_frame_queue_claim(q);
+    for (size_t i = 0; i < q->length; i++)
+        slot[i] = (rgb_t){ (uint8_t)i, 1, i >= lo && i < hi ? 9 : 2 };
+    led_frame_queue_publish(q);
+    EXPECT(led_frame_queue_apply(q));
+}
+
+static void check_queue_apply(void)
+{
+    led_strip_t rgb = { .type = LED_STRIP_WS2812, .length = 40, .gpio = 18 };
+    led_strip_t rgbw = { .type = LED_STRIP_SK6812, .length = 40, .gpio = 19 };
+    led_strip_t lin = { .type = LED_STRIP_WS2812, .length = 40, .gpio = 20, .linear16 = true };
+
+    led_strip_init(&rgb);
+    led_strip_init(&rgbw);
+    led_strip_init(&lin);
+    EXPECT(rgb.buf && rgbw.buf && lin.buf);
+    if (!rgb.buf || !rgbw.buf || !lin.buf)
+        return;
+
+    led_strip_t *all[] = { &rgb, &rgbw, &lin };
+    for (int s = 0; s < 3; s++) {
+        led_frame_queue_t q;
+        EXPECT(led_frame_queue_init(&q, &all[s], 1) == ESP_OK);
+
+        apply_change(&q, all[s], 10, 15);
+        if (all[s] == &rgb)
+            EXPECT(rgb.dirty_start == 10 && rgb.dirty_end == 15);
+        else
+            EXPECT(all[s]->dirty_start == 0 && all[s]->dirty_end == all[s]->length);
+
+        /* Same frame again: RGB strips stay clean */
+        rgb_t *slot = led_frame_queue_claim(&q);
+        memcpy(slot, q.slots + (size_t)q.front * q.length, q.length * sizeof(rgb_t));
+        led_frame_queue_publish(&q);
+        led_strip_refresh(all[s]);
+        EXPECT(led_frame_queue_apply(&q));
+        if (all[s] == &rgb)
+            EXPECT(rgb.dirty_end == 0);
+
+        led_frame_queue_free(&q);
+    }
+
+    /* Two strips back to back: each gets its own part */
+    led_frame_queue_t q;
+    led_strip_t *pair[] = { &rgb, &rgbw };
+    EXPECT(led_frame_queue_init(&q, pair, 2) == ESP_OK);
+    EXPECT(q.length == 80);
+
+    rgb_t *slot = led_frame_queue_claim(&q);
+    for (size_t i = 0; i < q.length; i++)
+        slot[i] = (rgb_t){ (uint8_t)i, 0, 0 };
+    led_frame_queue_publish(&q);
+    EXPECT(led_frame_queue_apply(&q));
+    EXPECT(pixel_at(&rgb, 39).r == 39);
+    EXPECT(pixel_at(&rgbw, 0).r == 40 && pixel_at(&rgbw, 39).r == 79);
+
+    led_frame_queue_free(&q);
+    led_strip_free(&rgb);
+    led_strip_free(&rgbw);
+    led_strip_free(&lin);
+}
+
+/* Producer and consumer on two threads: every frame
+   taken whole, newer than the last, none lost */
+#define STRESS_FRAMES 200000u
+
+static void *stress_producer(void *arg)
+{
+    led_frame_queue_t *q = arg;
+
+    for (uint32_t seq = 1; seq <= STRESS_FRAMES; seq++) {
+        fill_frame(led_frame_queue_claim(q), q->length, seq);
+        led_frame_queue_publish(q);
+
+        /* Interleave on single-core hosts too */
+        if (seq % 8 == 0)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void check_queue_threads(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 64, .gpio = 18 };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    led_strip_t *strips[] = { &strip };
+    led_frame_queue_t q;
+    EXPECT(led_frame_queue_init(&q, strips, 1) == ESP_OK);
+
+    pthread_t producer;
+    EXPECT(pthread_create(&producer, NULL, stress_producer, &q) == 0);
+
+    uint32_t last = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+
+    while (last != STRESS_FRAMES) {
+        const rgb_t *frame = led_frame_queue_take(&q);
+        if (!frame) {
+            sched_yield();
+            continue;
+        }
+
+        uint32_t seq = frame_seq(frame);
+        for (size_t i = 1; i < q.length; i++) {
+            if (memcmp(&frame[i], &frame[0], sizeof(rgb_t))) {
+                torn++;
+                break;
+            }
+        }
+        if (seq <= last)
+            backwards++;
+        last = seq;
+    }
+
+    pthread_join(producer, NULL);
+
+    EXPECT(torn == 0);
+    EXPECT(backwards == 0);
+    EXPECT(q.published == STRESS_FRAMES);
+    EXPECT(q.taken + q.dropped == STRESS_FRAMES);
+
+    led_frame_queue_free(&q);
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   SPI backend: the MOSI stream decodes back to the
+   staged bytes, latch padding follows
+==================================================*/
+
+/* 4 SPI bits per LED bit, MSB first; every nibble must
+   be exactly zero or one. Returns bytes decoded, stops
+   at the first nibble that is neither. */
+static size_t spi_decode(const uint8_t *mosi, size_t num_bytes, uint8_t zero, uint8_t one,
+                         uint8_t *out, size_t out_size)
+{
+    size_t n = 0;
+
+    for (; n < out_size && (n + 1) * 4 <= num_bytes; n++) {
+        uint8_t v = 0;
+
+        for (unsigned bit = 0; bit < 8; bit++) {
+            const uint8_t b = mosi[n * 4 + bit / 2];
+            const uint8_t nibble = bit & 1 ? b & 0xf : b >> 4;
+
+            if (nibble != zero && nibble != one)
+                return n;
+            v = (uint8_t)(v << 1 | (nibble == one));
+        }
+        out[n] = v;
+    }
+
+    return n;
+}
+
+static void check_spi_bitstream(led_strip_type_t type)
+{
+    const bool rgbw = type == LED_STRIP_SK6812;
+    const size_t wire_bpp = rgbw ? 4 : 3;
+    const uint8_t one = rgbw ? 0xC : 0xE;
+    const uint32_t reset_us = rgbw ? 80 : 60;
+
+    /* More than one 32-pixel staging chunk */
+    led_strip_t strip = {
+        .type = type, .length = 40, .gpio = 18,
+        .backend = LED_STRIP_BACKEND_SPI, .spi_host = SPI2_HOST,
+    };
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    static const uint8_t k_bytes[] = { 0x00, 0xff, 0xa5, 0x5a, 0x01, 0x80, 0x3c, 0x96 };
+    uint8_t want[40 * 4];
+
+    for (size_t i = 0; i < strip.length; i++) {
+        const uint8_t r = k_bytes[i % 8];
+        const uint8_t g = k_bytes[(i + 3) % 8] ^ (uint8_t)i;
+        const uint8_t b = k_bytes[(i + 5) % 8];
+        const uint8_t w = (uint8_t)(i * 37);
+
+        /* Wire order: G, R, B (then W) */
+        uint8_t *px = &want[i * wire_bpp];
+        px[0] = g;
+        px[1] = r;
+        px[2] = b;
+        if (rgbw) {
+            px[3] = w;
+            led_strip_set_pixel_rgbw(&strip, i, (rgbw_t){ r, g, b, w });
+        } else {
+            led_strip_set_pixel(&strip, i, (rgb_t){ r, g, b });
+        }
+    }
+    led_strip_refresh(&strip);
+
+    size_t n;
+    const uint8_t *mosi = spi_sim_last_frame(strip.spi, &n);
+    const size_t data = strip.length * wire_bpp;
+
+    uint8_t got[40 * 4];
+    EXPECT(mosi && spi_decode(mosi, n, 0x8, one, got, data) == data);
+    EXPECT(!memcmp(got, want, data));
+
+    /* Latch: zero bits after the data, at least reset_us
+       long (312.5 ns per SPI bit) */
+    EXPECT(n > data * 4);
+    size_t latch = n - data * 4;
+    bool zero = true;
+    for (size_t i = 0; i < latch; i++)
+        zero &= mosi[data * 4 + i] == 0;
+    EXPECT(zero);
+    EXPECT(latch * 8 * 3125 >= reset_us * 10000);
+
+    /* Dirty prefix: pixels 0..5 only, latch still there */
+    led_strip_set_pixel(&strip, 5, (rgb_t){ 0x12, 0x34, 0x56 });
+    led_strip_refresh(&strip);
+
+    mosi = spi_sim_last_frame(strip.spi, &n);
+    EXPECT(n == 6 * wire_bpp * 4 + latch);
+    EXPECT(spi_decode(mosi, n, 0x8, one, got, 6 * wire_bpp) == 6 * wire_bpp);
+    EXPECT(got[5 * wire_bpp] == 0x34 && got[5 * wire_bpp + 1] == 0x12 && got[5 * wire_bpp + 2] == 0x56);
+    EXPECT(!memcmp(got, want, 5 * wire_bpp));
+
+    led_strip_free(&strip);
+}
+
+/* =================================================
+   RMT load: refills as simulated, ISR time only when
+   it was measured
+==================================================*/
+static void check_rmt_load(void)
+{
+    led_strip_t strip = { .type = LED_STRIP_WS2812, .length = 1000, .gpio = 18 };
+    led_strip_rmt_load_t load;
+
+    led_strip_init(&strip);
+    EXPECT(strip.buf != NULL);
+    if (!strip.buf)
+        return;
+
+    /* Nothing sent yet: no measurement */
+    EXPECT(led_strip_get_rmt_load(&strip, &load) == ESP_OK);
+    EXPECT(!load.measured && load.isr_us == 0 && load.isr_load_permille == 0);
+
+    led_strip_fill(&strip, (rgb_t){ 1, 2, 3 });
+    led_strip_refresh(&strip);
+
+    rmt_sim_stats_t st;
+    rmt_sim_get_stats(strip.channel, &st);
+
+    EXPECT(led_strip_get_rmt_load(&strip, &load) == ESP_OK);
+    EXPECT(load.refills == st.last_refills);
+    EXPECT((uint64_t)load.refill_period_us * 1000 <= st.min_refill_ns);
+    EXPECT(load.measured == (bool)LED_STRIP_STATS);
+
+    led_strip_free(&strip);
+}
+
+int main(void)
+{
+    check_dirty_prefix();
+    check_dither_average();
+    check_rgbw();
+    check_matrix();
+    check_palette4();
+    check_color_tables();
+    check_layer_gaps(LED_STRIP_WS2812);
+    check_layer_gaps(LED_STRIP_SK6812);     /* scratch row + span copy */
+    check_sched();
+    check_group_linear16();
+    check_group_rounds();
+    check_group_abort();
+    check_group_wait_deadline();
+    check_done_callback();
+    check_queue_handover();
+    check_queue_apply();
+    check_queue_threads();
+    check_rmt_load();
+    check_spi_bitstream(LED_STRIP_WS2812);
+    check_spi_bitstream(LED_STRIP_SK6812);
+    check_dmx_e131_filters();
+    check_dmx_artnet_filters();
+    check_dmx_sync();
+    check_dmx_artnet_sync();
+
+    printf("%s (%d failed)\n", s_failed ? "FAIL" : "OK", s_failed);
+    return s_failed;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST STAND-IN: driver/rmt_types.h
+
+    Layouts follow ESP-IDF 5.x so library code
+    compiles unchanged against the simulator.
+*/
+
+typedef struct rmt_channel_t *rmt_channel_handle_t;
+typedef struct rmt_encoder_t *rmt_encoder_handle_t;
+
+typedef enum {
+    RMT_CLK_SRC_DEFAULT = 0,
+} rmt_clock_source_t;
+
+/* One RMT symbol = two (level, duration) halves */
+typedef union {
+    struct {
+        uint16_t duration0 : 15;
+        uint16_t level0    : 1;
+        uint16_t duration1 : 15;
+        uint16_t level1    : 1;
+    };
+    uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct {
+    size_t num_symbols;
+} rmt_tx_done_event_data_t;
+
+typedef bool (*rmt_tx_done_callback_t)(rmt_channel_handle_t tx_chan,
+                                       const rmt_tx_done_event_data_t *edata,
+                                       void *user_ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST STAND-IN: driver/spi_master.h
+
+    Backed by host/spi_sim.c (TX only, MOSI bits are
+    recorded; wire time from the device clock)
+*/
+
+typedef enum {
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+    SPI3_HOST = 2,
+    SPI_HOST_MAX,
+} spi_host_device_t;
+
+typedef enum {
+    SPI_DMA_DISABLED = 0,
+    SPI_DMA_CH_AUTO  = 3,
+} spi_common_dma_t;
+
+typedef struct {
+    int      mosi_io_num;
+    int      miso_io_num;
+    int      sclk_io_num;
+    int      quadwp_io_num;
+    int      quadhd_io_num;
+    int      max_transfer_sz;   /* bytes, 0 = 4092 */
+    uint32_t flags;
+    int      intr_flags;
+} spi_bus_config_t;
+
+typedef struct spi_transaction_t spi_transaction_t;
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+struct spi_transaction_t {
+    uint32_t    flags;
+    uint16_t    cmd;
+    uint64_t    addr;
+    size_t      length;     /* bits */
+    size_t      rxlength;
+    void       *user;
+    const void *tx_buffer;
+    void       *rx_buffer;
+};
+
+typedef struct {
+    uint8_t          command_bits;
+    uint8_t          address_bits;
+    uint8_t          dummy_bits;
+    uint8_t          mode;
+    int              clock_speed_hz;
+    int              spics_io_num;   /* -1 = no CS */
+    uint32_t         flags;
+    int              queue_size;
+    transaction_cb_t pre_cb;
+    transaction_cb_t post_cb;        /* "ISR", transaction done */
+} spi_device_interface_config_t;
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host,
+                             const spi_bus_config_t *bus_config,
+                             spi_common_dma_t dma_chan);
+esp_err_t spi_bus_free(spi_host_device_t host);
+
+esp_err_t spi_bus_add_device(spi_host_device_t host,
+                             const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle,
+                                 spi_transaction_t *trans_desc,
+                                 TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle,
+                                      spi_transaction_t **trans_desc,
+                                      TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
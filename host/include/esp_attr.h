@@ -0,0 +1,9 @@
+#pragma once
+
+/*
+    HOST STAND-IN: esp_attr.h
+*/
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define FORCE_INLINE_ATTR static inline __attribute__((always_inline))
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST STAND-IN: esp_cpu.h
+
+    Cycle counter = real monotonic nanoseconds
+    (1000 "cycles" per us, see esp_rom_get_cpu_ticks_per_us),
+    so CPU-side timings measure the host's real work.
+*/
+typedef uint32_t esp_cpu_cycle_count_t;
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void);
+
+#ifdef __cplusplus
+}
+#endif
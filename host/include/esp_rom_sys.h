@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST STAND-IN: esp_rom_sys.h
+
+    Busy-wait is modelled as an advance of the
+    simulated clock (see rmt_sim.h), not a real spin.
+*/
+void esp_rom_delay_us(uint32_t us);
+
+/* Cycle counter rate (esp_cpu.h): 1000 on the host */
+uint32_t esp_rom_get_cpu_ticks_per_us(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST STAND-IN: esp_timer.h
+
+    Microseconds of simulated time (see rmt_sim.h).
+*/
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+    HOST STAND-IN: freertos/FreeRTOS.h
+
+    1 tick = 1 ms of simulated time
+*/
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define configTICK_RATE_HZ   1000
+#define portTICK_PERIOD_MS   ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY        ((TickType_t)0xffffffffUL)
+
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms) * configTICK_RATE_HZ / 1000)
+
+/* Nothing to switch to on the host */
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+#define pdFALSE  ((BaseType_t)0)
+#define pdTRUE   ((BaseType_t)1)
+#define pdFAIL   pdFALSE
+#define pdPASS   pdTRUE
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST STAND-IN: freertos/task.h
+
+    Delays advance the simulated clock (see rmt_sim.h).
+    Single-threaded: task creation always fails, code
+    that owns a task must also expose its loop body.
+*/
+typedef struct host_task_t *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+#define tskNO_AFFINITY ((BaseType_t)0x7fffffff)
+
+void       vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn,
+                                   const char *name,
+                                   uint32_t stack_depth,
+                                   void *arg,
+                                   UBaseType_t priority,
+                                   TaskHandle_t *ret_task,
+                                   BaseType_t core_id);
+void       vTaskDelete(TaskHandle_t task);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST FREERTOS INSPECTION (HOST BUILD ONLY)
+
+    Task creation always fails on the host (see
+    freertos/task.h); the arguments of the last
+    attempt are kept so checks can see them.
+*/
+
+typedef struct {
+    uint32_t    stack_depth;
+    UBaseType_t priority;
+    BaseType_t  core_id;
+} freertos_sim_task_req_t;
+
+void freertos_sim_last_task(freertos_sim_task_req_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "driver/rmt_tx.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST RMT SIMULATOR (HOST BUILD ONLY)
+
+    - Stands in for driver/rmt_tx.h on Linux
+    - Encoders run for real, symbols are recorded
+    - Wire time derived from symbol durations at the
+      channel resolution (10 MHz -> 100 ns per tick)
+    - Time is simulated: waits / delays advance a
+      virtual clock instead of sleeping
+    - Symbol memory is refilled ping-pong like the
+      driver does: whole block first, then one half per
+      refill interrupt (counted, with its deadline)
+*/
+
+/* -------------------------------------------------
+   Per-channel counters
+--------------------------------------------------*/
+typedef struct {
+    uint32_t frames;        /* completed transmissions        */
+    uint64_t symbols;       /* symbols put on the wire        */
+    uint64_t refills;       /* refill interrupts (half blocks
+                               after the first fill)          */
+    uint32_t last_refills;  /* refills of the last frame      */
+    uint64_t min_refill_ns; /* tightest refill deadline seen:
+                               wire time of half a block      */
+    uint64_t wire_ns;       /* total simulated wire time      */
+    uint64_t last_wire_ns;  /* wire time of the last frame    */
+    uint32_t busy_sync_resets; /* sync resets rejected while this
+                                  channel still had frames queued */
+} rmt_sim_stats_t;
+
+/* -------------------------------------------------
+   Simulated clock
+--------------------------------------------------*/
+uint64_t rmt_sim_now_ns(void);
+void     rmt_sim_advance_ns(uint64_t ns);
+
+/* Run the next transmit completion due at or before
+   limit_ns (clock jumps to it, on_trans_done fires).
+   Returns false if nothing is due. */
+bool     rmt_sim_step(uint64_t limit_ns);
+
+/* Other simulated peripherals (spi_sim.c) share the
+   clock: next_due = earliest pending completion
+   (UINT64_MAX = none), fire = complete it ("ISR") */
+typedef struct {
+    uint64_t (*next_due)(void);
+    void     (*fire)(void);
+} rmt_sim_peer_t;
+
+void     rmt_sim_add_peer(const rmt_sim_peer_t *peer);
+
+/* -------------------------------------------------
+   Inspection
+--------------------------------------------------*/
+esp_err_t rmt_sim_get_stats(rmt_channel_handle_t channel,
+                            rmt_sim_stats_t *out);
+
+/* Symbols of the most recently submitted frame */
+const rmt_symbol_word_t *rmt_sim_last_frame(rmt_channel_handle_t channel,
+                                            size_t *num_symbols);
+
+/* Turn WS2812 data symbols back into bytes (MSB first).
+   Stops at the first non-data (low) symbol.
+   Returns number of whole bytes written. */
+size_t rmt_sim_decode_bytes(const rmt_symbol_word_t *symbols,
+                            size_t num_symbols,
+                            uint8_t *out,
+                            size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
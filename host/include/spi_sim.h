@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "driver/spi_master.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HOST SPI SIMULATOR (HOST BUILD ONLY)
+
+    - Stands in for driver/spi_master.h on Linux, TX only
+    - MOSI bytes of every transaction are recorded
+    - Wire time = bits / device clock, on the same
+      simulated clock as the RMT simulator (rmt_sim.h);
+      post_cb fires when the clock passes it
+*/
+
+typedef struct {
+    uint32_t frames;        /* completed transactions         */
+    uint64_t bytes;         /* MOSI bytes put on the wire     */
+    uint64_t wire_ns;       /* total simulated wire time      */
+    uint64_t last_wire_ns;  /* wire time of the last frame    */
+} spi_sim_stats_t;
+
+esp_err_t spi_sim_get_stats(spi_device_handle_t device, spi_sim_stats_t *out);
+
+/* MOSI bytes of the most recently queued transaction */
+const uint8_t *spi_sim_last_frame(spi_device_handle_t device, size_t *num_bytes);
+
+/* Turn an SPI-coded WS2812 stream back into bytes: every
+   bits_per_bit MOSI bits (MSB first) are one LED bit,
+   1 = high for at least half of it. Stops at the first
+   group that does not start high (latch).
+   Returns number of whole bytes written. */
+size_t spi_sim_decode_bytes(const uint8_t *mosi,
+                            size_t num_bytes,
+                            unsigned bits_per_bit,
+                            uint8_t *out,
+                            size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,780 @@
+#include "rmt_sim.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+/*
+    HOST RMT SIMULATOR
+
+    rmt_transmit() runs the encoder to completion right away,
+    the same way the driver fills channel memory on hardware:
+    the first call gets the whole block, every later call
+    (one refill interrupt each) the half that just drained.
+    The frame is then queued on the channel and "finishes"
+    once the simulated clock passes its wire time.
+
+    Channel memory is a shared pool of 64-symbol blocks
+    (ESP32: 8 x 64); a DMA channel takes one block and its
+    buffer lives in RAM, only one channel can have DMA.
+*/
+
+#define SIM_MAX_CHANNELS 8
+
+#define SIM_MEM_BLOCK_SYMBOLS 64
+#define SIM_MEM_BLOCKS        8
+#define SIM_DMA_CHANNELS      1
+
+/* Queued in a sync round that has not started yet */
+#define SIM_NOT_STARTED  UINT64_MAX
+
+#define CHECK_ARG(x) do { if (!(x)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/* =================================================
+   Channel
+==================================================*/
+typedef struct {
+    uint64_t done_ns;
+    size_t   num_symbols;
+} sim_pending_t;
+
+struct rmt_channel_t {
+    rmt_tx_channel_config_t cfg;
+    bool                    enabled;
+
+    /* Channel symbol memory (or DMA buffer) */
+    rmt_symbol_word_t      *mem;
+    size_t                  mem_used;
+    size_t                  mem_window;     /* whole block, then halves */
+    size_t                  mem_blocks;     /* taken from the pool */
+
+    /* Last submitted frame */
+    rmt_symbol_word_t      *frame;
+    size_t                  frame_len;
+    size_t                  frame_cap;
+    uint64_t                frame_ticks;
+
+    /* In-flight transactions (FIFO) */
+    sim_pending_t          *pending;
+    size_t                  pending_head;
+    size_t                  pending_count;
+    uint64_t                busy_until_ns;
+
+    rmt_tx_event_callbacks_t cbs;
+    void                    *cbs_ctx;
+
+    /* Sync group membership */
+    struct rmt_sync_manager_t *sync;
+    uint32_t                sync_bit;
+    size_t                  armed_slot;
+    uint64_t                armed_wire_ns;
+
+    rmt_sim_stats_t         stats;
+};
+
+struct rmt_sync_manager_t {
+    rmt_channel_handle_t members[SIM_MAX_CHANNELS];
+    size_t               count;
+    uint32_t             all;
+    uint32_t             armed;
+};
+
+static rmt_channel_handle_t s_channels[SIM_MAX_CHANNELS];
+static uint64_t             s_now_ns;
+static size_t               s_mem_blocks;
+static size_t               s_dma_channels;
+
+/* Other simulated peripherals on the same clock */
+#define SIM_MAX_PEERS 4
+
+static const rmt_sim_peer_t *s_peers[SIM_MAX_PEERS];
+
+/* =================================================
+   Simulated clock
+==================================================*/
+bool rmt_sim_step(uint64_t limit_ns)
+{
+    rmt_channel_handle_t next = NULL;
+    uint64_t next_done = 0;
+
+    for (int i = 0; i < SIM_MAX_CHANNELS; i++) {
+        rmt_channel_handle_t ch = s_channels[i];
+        if (!ch || ch->pending_count == 0)
+            continue;
+
+        uint64_t done = ch->pending[ch->pending_head].done_ns;
+        if (done != SIM_NOT_STARTED && done <= limit_ns && (!next || done < next_done)) {
+            next = ch;
+            next_done = done;
+        }
+    }
+
+    /* A peer completion due first runs instead */
+    const rmt_sim_peer_t *peer = NULL;
+    for (int i = 0; i < SIM_MAX_PEERS; i++) {
+        if (!s_peers[i])
+            continue;
+
+        uint64_t done = s_peers[i]->next_due();
+        if (done != UINT64_MAX && done <= limit_ns && ((!next && !peer) || done < next_done)) {
+            peer = s_peers[i];
+            next_done = done;
+        }
+    }
+
+    if (peer) {
+        if (next_done > s_now_ns)
+            s_now_ns = next_done;
+        peer->fire();
+        return true;
+    }
+
+    if (!next)
+        return false;
+
+    if (next_done > s_now_ns)
+        s_now_ns = next_done;
+
+    rmt_tx_done_event_data_t edata = {
+        .num_symbols = next->pending[next->pending_head].num_symbols,
+    };
+
+    next->pending_head = (next->pending_head + 1) % next->cfg.trans_queue_depth;
+    next->pending_count--;
+    next->stats.frames++;
+
+    /* "ISR" context */
+    if (next->cbs.on_trans_done)
+        next->cbs.on_trans_done(next, &edata, next->cbs_ctx);
+
+    return true;
+}
+
+static void sim_advance_to(uint64_t t)
+{
+    while (rmt_sim_step(t))
+        ;
+
+    if (t > s_now_ns)
+        s_now_ns = t;
+}
+
+void rmt_sim_add_peer(const rmt_sim_peer_t *peer)
+{
+    for (int i = 0; i < SIM_MAX_PEERS; i++) {
+        if (s_peers[i] == peer)
+            return;
+    }
+
+    for (int i = 0; i < SIM_MAX_PEERS; i++) {
+        if (!s_peers[i]) {
+            s_peers[i] = peer;
+            return;
+        }
+    }
+}
+
+uint64_t rmt_sim_now_ns(void)
+{
+    return s_now_ns;
+}
+
+void rmt_sim_advance_ns(uint64_t ns)
+{
+    sim_advance_to(s_now_ns + ns);
+}
+
+void esp_rom_delay_us(uint32_t us)
+{
+    rmt_sim_advance_ns((uint64_t)us * 1000);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)(s_now_ns / 1000);
+}
+
+/* CPU work is real, not simulated: cycle counter runs on
+   the host's monotonic clock, 1 "cycle" = 1 ns */
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (esp_cpu_cycle_count_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+uint32_t esp_rom_get_cpu_ticks_per_us(void)
+{
+    return 1000;
+}
+
+/* =================================================
+   Channel memory
+==================================================*/
+static inline size_t sim_mem_free(rmt_channel_handle_t ch)
+{
+    return ch->mem_window - ch->mem_used;
+}
+
+/* Hardware drained the window -> append it to the frame;
+   a full window also sets the refill deadline (wire time
+   of half a block) */
+static esp_err_t sim_mem_flush(rmt_channel_handle_t ch)
+{
+    if (ch->mem_used == 0)
+        return ESP_OK;
+
+    if (ch->frame_len + ch->mem_used > ch->frame_cap) {
+        size_t cap = ch->frame_cap ? ch->frame_cap : 1024;
+        while (cap < ch->frame_len + ch->mem_used)
+            cap *= 2;
+
+        rmt_symbol_word_t *grown = realloc(ch->frame, cap * sizeof(*grown));
+        if (!grown)
+            return ESP_ERR_NO_MEM;
+
+        ch->frame = grown;
+        ch->frame_cap = cap;
+    }
+
+    uint64_t ticks = 0;
+    for (size_t i = 0; i < ch->mem_used; i++)
+        ticks += ch->mem[i].duration0 + ch->mem[i].duration1;
+
+    if (ch->mem_used == ch->mem_window) {
+        uint64_t half_ns = ticks * 1000000000ULL / ch->cfg.resolution_hz
+                         * (ch->cfg.mem_block_symbols / 2) / ch->mem_used;
+        if (ch->stats.min_refill_ns == 0 || half_ns < ch->stats.min_refill_ns)
+            ch->stats.min_refill_ns = half_ns;
+    }
+
+    memcpy(&ch->frame[ch->frame_len], ch->mem, ch->mem_used * sizeof(*ch->mem));
+    ch->frame_ticks += ticks;
+    ch->frame_len += ch->mem_used;
+    ch->mem_used = 0;
+    ch->mem_window = ch->cfg.mem_block_symbols / 2;
+
+    return ESP_OK;
+}
+
+/* =================================================
+   Channel lifecycle
+==================================================*/
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t *config,
+                             rmt_channel_handle_t *ret_chan)
+{
+    CHECK_ARG(config && ret_chan);
+    CHECK_ARG(config->resolution_hz > 0);
+    CHECK_ARG(config->mem_block_symbols >= 2 && config->mem_block_symbols % 2 == 0);
+    CHECK_ARG(config->trans_queue_depth > 0);
+    CHECK_ARG(config->intr_priority >= 0 && config->intr_priority <= 3);
+
+    /* DMA buffer is RAM, the channel still owns one block */
+    size_t blocks = config->flags.with_dma ? 1
+                  : (config->mem_block_symbols + SIM_MEM_BLOCK_SYMBOLS - 1) / SIM_MEM_BLOCK_SYMBOLS;
+    if (s_mem_blocks + blocks > SIM_MEM_BLOCKS)
+        return ESP_ERR_NOT_FOUND;
+    if (config->flags.with_dma && s_dma_channels == SIM_DMA_CHANNELS)
+        return ESP_ERR_NOT_FOUND;
+
+    int slot = -1;
+    for (int i = 0; i < SIM_MAX_CHANNELS; i++) {
+        if (!s_channels[i]) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0)
+        return ESP_ERR_NOT_FOUND;
+
+    rmt_channel_handle_t ch = calloc(1, sizeof(*ch));
+    if (!ch)
+        return ESP_ERR_NO_MEM;
+
+    ch->cfg = *config;
+    ch->mem = calloc(config->mem_block_symbols, sizeof(*ch->mem));
+    ch->pending = calloc(config->trans_queue_depth, sizeof(*ch->pending));
+    if (!ch->mem || !ch->pending) {
+        free(ch->mem);
+        free(ch->pending);
+        free(ch);
+        return ESP_ERR_NO_MEM;
+    }
+
+    ch->mem_blocks = blocks;
+    s_mem_blocks += blocks;
+    if (config->flags.with_dma)
+        s_dma_channels++;
+
+    s_channels[slot] = ch;
+    *ret_chan = ch;
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel)
+{
+    CHECK_ARG(channel);
+    if (channel->enabled || channel->sync)
+        return ESP_ERR_INVALID_STATE;
+
+    for (int i = 0; i < SIM_MAX_CHANNELS; i++) {
+        if (s_channels[i] == channel)
+            s_channels[i] = NULL;
+    }
+
+    s_mem_blocks -= channel->mem_blocks;
+    if (channel->cfg.flags.with_dma)
+        s_dma_channels--;
+
+    free(channel->mem);
+    free(channel->pending);
+    free(channel->frame);
+    free(channel);
+    return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel)
+{
+    CHECK_ARG(channel);
+    if (channel->enabled)
+        return ESP_ERR_INVALID_STATE;
+
+    channel->enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t rmt_disable(rmt_channel_handle_t channel)
+{
+    CHECK_ARG(channel);
+    if (!channel->enabled)
+        return ESP_ERR_INVALID_STATE;
+
+    /* Abort whatever is still on the wire */
+    channel->pending_count = 0;
+    if (channel->sync)
+        channel->sync->armed &= ~channel->sync_bit;
+    channel->busy_until_ns = s_now_ns;
+    channel->enabled = false;
+    return ESP_OK;
+}
+
+/* =================================================
+   Sync manager
+==================================================*/
+
+/* Last member armed -> everyone starts at the same instant */
+static void sim_sync_try_start(struct rmt_sync_manager_t *sync)
+{
+    if (sync->armed != sync->all)
+        return;
+
+    uint64_t start = s_now_ns;
+    for (size_t i = 0; i < sync->count; i++) {
+        if (sync->members[i]->busy_until_ns > start)
+            start = sync->members[i]->busy_until_ns;
+    }
+
+    for (size_t i = 0; i < sync->count; i++) {
+        rmt_channel_handle_t ch = sync->members[i];
+
+        ch->busy_until_ns = start + ch->armed_wire_ns;
+        ch->pending[ch->armed_slot].done_ns = ch->busy_until_ns;
+    }
+
+    sync->armed = 0;
+}
+
+esp_err_t rmt_new_sync_manager(const rmt_sync_manager_config_t *config,
+                               rmt_sync_manager_handle_t *ret_synchro)
+{
+    CHECK_ARG(config && ret_synchro && config->tx_channel_array);
+    CHECK_ARG(config->array_size > 0 && config->array_size <= SIM_MAX_CHANNELS);
+
+    for (size_t i = 0; i < config->array_size; i++) {
+        rmt_channel_handle_t ch = config->tx_channel_array[i];
+        CHECK_ARG(ch);
+        if (ch->sync)
+            return ESP_ERR_INVALID_STATE;
+    }
+
+    struct rmt_sync_manager_t *sync = calloc(1, sizeof(*sync));
+    if (!sync)
+        return ESP_ERR_NO_MEM;
+
+    for (size_t i = 0; i < config->array_size; i++) {
+        rmt_channel_handle_t ch = config->tx_channel_array[i];
+
+        sync->members[i] = ch;
+        ch->sync = sync;
+        ch->sync_bit = 1u << i;
+        sync->all |= ch->sync_bit;
+    }
+    sync->count = config->array_size;
+
+    *ret_synchro = sync;
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_sync_manager(rmt_sync_manager_handle_t synchro)
+{
+    CHECK_ARG(synchro);
+
+    for (size_t i = 0; i < synchro->count; i++)
+        synchro->members[i]->sync = NULL;
+
+    free(synchro);
+    return ESP_OK;
+}
+
+esp_err_t rmt_sync_reset(rmt_sync_manager_handle_t synchro)
+{
+    CHECK_ARG(synchro);
+
+    /* Re-arming mid-round would split the next start */
+    bool busy = false;
+    for (size_t i = 0; i < synchro->count; i++) {
+        if (synchro->members[i]->pending_count) {
+            synchro->members[i]->stats.busy_sync_resets++;
+            busy = true;
+        }
+    }
+    if (busy)
+        return ESP_ERR_INVALID_STATE;
+
+    synchro->armed = 0;
+    return ESP_OK;
+}
+
+/* =================================================
+   Transmit
+==================================================*/
+esp_err_t rmt_transmit(rmt_channel_handle_t tx_channel,
+                       rmt_encoder_handle_t encoder,
+                       const void *payload,
+                       size_t payload_bytes,
+                       const rmt_transmit_config_t *config)
+{
+    rmt_channel_handle_t ch = tx_channel;
+
+    CHECK_ARG(ch && encoder && config);
+    CHECK_ARG(payload || payload_bytes == 0);
+    if (!ch->enabled)
+        return ESP_ERR_INVALID_STATE;
+
+    /* Queue full -> block until the oldest frame is out */
+    if (ch->pending_count == ch->cfg.trans_queue_depth) {
+        if (config->flags.queue_nonblocking)
+            return ESP_ERR_INVALID_STATE;
+        sim_advance_to(ch->pending[ch->pending_head].done_ns);
+    }
+
+    rmt_encoder_reset(encoder);
+    ch->mem_used = 0;
+    ch->mem_window = ch->cfg.mem_block_symbols;
+    ch->frame_len = 0;
+    ch->frame_ticks = 0;
+
+    /* Calls after the first = refill interrupts */
+    uint32_t refills = 0;
+
+    for (bool first = true;; first = false) {
+        if (!first)
+            refills++;
+
+        rmt_encode_state_t state = RMT_ENCODING_RESET;
+        size_t written = encoder->encode(encoder, ch, payload, payload_bytes, &state);
+
+        if (state & RMT_ENCODING_MEM_FULL) {
+            esp_err_t err = sim_mem_flush(ch);
+            if (err != ESP_OK)
+                return err;
+        }
+
+        if (state & RMT_ENCODING_COMPLETE)
+            break;
+
+        /* Encoder neither finished nor filled memory */
+        if (!(state & RMT_ENCODING_MEM_FULL) && written == 0)
+            return ESP_FAIL;
+    }
+
+    esp_err_t err = sim_mem_flush(ch);
+    if (err != ESP_OK)
+        return err;
+
+    uint64_t wire_ns = ch->frame_ticks * 1000000000ULL / ch->cfg.resolution_hz;
+    size_t tail = (ch->pending_head + ch->pending_count) % ch->cfg.trans_queue_depth;
+
+    ch->pending[tail].num_symbols = ch->frame_len;
+    ch->pending_count++;
+
+    if (ch->sync) {
+        ch->pending[tail].done_ns = SIM_NOT_STARTED;
+        ch->armed_slot = tail;
+        ch->armed_wire_ns = wire_ns;
+        ch->sync->armed |= ch->sync_bit;
+        sim_sync_try_start(ch->sync);
+    } else {
+        uint64_t start = ch->busy_until_ns > s_now_ns ? ch->busy_until_ns : s_now_ns;
+
+        ch->busy_until_ns = start + wire_ns;
+        ch->pending[tail].done_ns = ch->busy_until_ns;
+    }
+
+    ch->stats.symbols += ch->frame_len;
+    ch->stats.refills += refills;
+    ch->stats.last_refills = refills;
+    ch->stats.wire_ns += wire_ns;
+    ch->stats.last_wire_ns = wire_ns;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t tx_channel, int timeout_ms)
+{
+    rmt_channel_handle_t ch = tx_channel;
+
+    CHECK_ARG(ch);
+    if (ch->pending_count == 0)
+        return ESP_OK;
+
+    /* Armed in a sync round that never got all its members */
+    if (ch->sync && (ch->sync->armed & ch->sync_bit)) {
+        if (timeout_ms < 0)
+            return ESP_ERR_INVALID_STATE;
+        sim_advance_to(s_now_ns + (uint64_t)timeout_ms * 1000000ULL);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* timeout_ms < 0 -> wait forever (portMAX_DELAY) */
+    if (timeout_ms >= 0) {
+        uint64_t limit = s_now_ns + (uint64_t)timeout_ms * 1000000ULL;
+        if (ch->busy_until_ns > limit) {
+            sim_advance_to(limit);
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+
+    sim_advance_to(ch->busy_until_ns);
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t tx_channel,
+                                          const rmt_tx_event_callbacks_t *cbs,
+                                          void *user_data)
+{
+    CHECK_ARG(tx_channel && cbs);
+    if (tx_channel->enabled)
+        return ESP_ERR_INVALID_STATE;
+
+    tx_channel->cbs = *cbs;
+    tx_channel->cbs_ctx = user_data;
+    return ESP_OK;
+}
+
+/* =================================================
+   Bytes encoder
+==================================================*/
+typedef struct {
+    rmt_encoder_t     base;
+    rmt_symbol_word_t bit0;
+    rmt_symbol_word_t bit1;
+    bool              msb_first;
+    size_t            byte_index;
+    unsigned          bit_index;
+} sim_bytes_encoder_t;
+
+static size_t sim_bytes_encode(rmt_encoder_t *encoder,
+                               rmt_channel_handle_t ch,
+                               const void *primary_data,
+                               size_t data_size,
+                               rmt_encode_state_t *ret_state)
+{
+    sim_bytes_encoder_t *enc = (sim_bytes_encoder_t *)encoder;
+    const uint8_t *data = primary_data;
+    size_t written = 0;
+
+    while (enc->byte_index < data_size) {
+        uint8_t b = data[enc->byte_index];
+
+        while (enc->bit_index < 8) {
+            if (sim_mem_free(ch) == 0) {
+                *ret_state = RMT_ENCODING_MEM_FULL;
+                return written;
+            }
+
+            unsigned shift = enc->msb_first ? 7 - enc->bit_index : enc->bit_index;
+            ch->mem[ch->mem_used++] = ((b >> shift) & 1) ? enc->bit1 : enc->bit0;
+            enc->bit_index++;
+            written++;
+        }
+
+        enc->bit_index = 0;
+        enc->byte_index++;
+    }
+
+    enc->byte_index = 0;
+    *ret_state = RMT_ENCODING_COMPLETE;
+    if (sim_mem_free(ch) == 0)
+        *ret_state |= RMT_ENCODING_MEM_FULL;
+
+    return written;
+}
+
+static esp_err_t sim_bytes_reset(rmt_encoder_t *encoder)
+{
+    sim_bytes_encoder_t *enc = (sim_bytes_encoder_t *)encoder;
+    enc->byte_index = 0;
+    enc->bit_index = 0;
+    return ESP_OK;
+}
+
+static esp_err_t sim_bytes_del(rmt_encoder_t *encoder)
+{
+    free(encoder);
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config,
+                                rmt_encoder_handle_t *ret_encoder)
+{
+    CHECK_ARG(config && ret_encoder);
+
+    sim_bytes_encoder_t *enc = calloc(1, sizeof(*enc));
+    if (!enc)
+        return ESP_ERR_NO_MEM;
+
+    enc->base.encode = sim_bytes_encode;
+    enc->base.reset = sim_bytes_reset;
+    enc->base.del = sim_bytes_del;
+    enc->bit0 = config->bit0;
+    enc->bit1 = config->bit1;
+    enc->msb_first = config->flags.msb_first;
+
+    *ret_encoder = &enc->base;
+    return ESP_OK;
+}
+
+/* =================================================
+   Copy encoder
+==================================================*/
+typedef struct {
+    rmt_encoder_t base;
+    size_t        index;     /* next symbol to copy */
+} sim_copy_encoder_t;
+
+static size_t sim_copy_encode(rmt_encoder_t *encoder,
+                              rmt_channel_handle_t ch,
+                              const void *primary_data,
+                              size_t data_size,
+                              rmt_encode_state_t *ret_state)
+{
+    sim_copy_encoder_t *enc = (sim_copy_encoder_t *)encoder;
+    const rmt_symbol_word_t *symbols = primary_data;
+    size_t count = data_size / sizeof(rmt_symbol_word_t);
+    size_t written = 0;
+
+    while (enc->index < count) {
+        if (sim_mem_free(ch) == 0) {
+            *ret_state = RMT_ENCODING_MEM_FULL;
+            return written;
+        }
+
+        ch->mem[ch->mem_used++] = symbols[enc->index++];
+        written++;
+    }
+
+    enc->index = 0;
+    *ret_state = RMT_ENCODING_COMPLETE;
+    if (sim_mem_free(ch) == 0)
+        *ret_state |= RMT_ENCODING_MEM_FULL;
+
+    return written;
+}
+
+static esp_err_t sim_copy_reset(rmt_encoder_t *encoder)
+{
+    ((sim_copy_encoder_t *)encoder)->index = 0;
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t *config,
+                               rmt_encoder_handle_t *ret_encoder)
+{
+    CHECK_ARG(config && ret_encoder);
+
+    sim_copy_encoder_t *enc = calloc(1, sizeof(*enc));
+    if (!enc)
+        return ESP_ERR_NO_MEM;
+
+    enc->base.encode = sim_copy_encode;
+    enc->base.reset = sim_copy_reset;
+    enc->base.del = sim_bytes_del;
+
+    *ret_encoder = &enc->base;
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder)
+{
+    CHECK_ARG(encoder);
+    return encoder->del(encoder);
+}
+
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder)
+{
+    CHECK_ARG(encoder);
+    return encoder->reset(encoder);
+}
+
+/* =================================================
+   Inspection
+==================================================*/
+esp_err_t rmt_sim_get_stats(rmt_channel_handle_t channel, rmt_sim_stats_t *out)
+{
+    CHECK_ARG(channel && out);
+    *out = channel->stats;
+    return ESP_OK;
+}
+
+const rmt_symbol_word_t *rmt_sim_last_frame(rmt_channel_handle_t channel,
+                                            size_t *num_symbols)
+{
+    if (!channel) {
+        if (num_symbols)
+            *num_symbols = 0;
+        return NULL;
+    }
+
+    if (num_symbols)
+        *num_symbols = channel->frame_len;
+    return channel->frame;
+}
+
+size_t rmt_sim_decode_bytes(const rmt_symbol_word_t *symbols,
+                            size_t num_symbols,
+                            uint8_t *out,
+                            size_t out_size)
+{
+    size_t n = 0;
+
+    for (size_t i = 0; i + 8 <= num_symbols && n < out_size; i += 8) {
+        uint8_t b = 0;
+
+        for (size_t k = 0; k < 8; k++) {
+            rmt_symbol_word_t s = symbols[i + k];
+            if (!s.level0)
+                return n;
+            /* 1 = high for at least half the bit (WS2812 + SK6812) */
+            b = (uint8_t)(b << 1) | (2u * s.duration0 >= (unsigned)s.duration0 + s.duration1);
+        }
+
+        out[n++] = b;
+    }
+
+    return n;
+}
@@ -0,0 +1,391 @@
+#include "spi_sim.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rmt_sim.h"
+
+/*
+    HOST SPI SIMULATOR
+
+    spi_device_queue_trans() records the MOSI bytes and
+    schedules the transaction after whatever the device
+    still has on the wire. Completions run through the RMT
+    simulator's clock (peer hook), so waits on either
+    peripheral advance both.
+
+    Each device owns a ring of queue_size slots: a slot is
+    busy from queue_trans until get_trans_result picks it
+    up, like the driver's queue pair.
+*/
+
+#define SIM_DEVS_PER_BUS 3
+
+/* Without DMA the driver moves at most one FIFO worth */
+#define SIM_FIFO_BYTES   64
+#define SIM_MAX_TRANSFER 4092
+
+#define CHECK_ARG(x) do { if (!(x)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/* =================================================
+   Bus + device
+==================================================*/
+typedef struct {
+    spi_transaction_t *trans;
+    uint64_t           done_ns;
+    bool               finished;
+} sim_slot_t;
+
+struct spi_device_t {
+    spi_host_device_t             host;
+    spi_device_interface_config_t cfg;
+
+    sim_slot_t                   *slots;
+    size_t                        head;
+    size_t                        count;
+    uint64_t                      busy_until_ns;
+
+    /* Last queued transaction */
+    uint8_t                      *frame;
+    size_t                        frame_len;
+    size_t                        frame_cap;
+
+    spi_sim_stats_t               stats;
+};
+
+typedef struct {
+    bool                used;
+    bool                dma;
+    size_t              max_transfer;
+    spi_device_handle_t devs[SIM_DEVS_PER_BUS];
+} sim_bus_t;
+
+static sim_bus_t s_buses[SPI_HOST_MAX];
+
+/* =================================================
+   Clock hook
+==================================================*/
+/* First slot still on the wire; slots finish in order */
+static sim_slot_t *sim_next_slot(spi_device_handle_t dev)
+{
+    for (size_t i = 0; i < dev->count; i++) {
+        sim_slot_t *slot = &dev->slots[(dev->head + i) % dev->cfg.queue_size];
+        if (!slot->finished)
+            return slot;
+    }
+    return NULL;
+}
+
+static spi_device_handle_t sim_next_device(uint64_t *due)
+{
+    spi_device_handle_t next = NULL;
+    *due = UINT64_MAX;
+
+    for (int h = 0; h < SPI_HOST_MAX; h++) {
+        for (int d = 0; d < SIM_DEVS_PER_BUS; d++) {
+            spi_device_handle_t dev = s_buses[h].devs[d];
+            sim_slot_t *slot = dev ? sim_next_slot(dev) : NULL;
+
+            if (slot && slot->done_ns < *due) {
+                next = dev;
+                *due = slot->done_ns;
+            }
+        }
+    }
+    return next;
+}
+
+static uint64_t sim_next_due(void)
+{
+    uint64_t due;
+    sim_next_device(&due);
+    return due;
+}
+
+/* "ISR": transaction done */
+static void sim_fire(void)
+{
+    uint64_t due;
+    spi_device_handle_t dev = sim_next_device(&due);
+    if (!dev)
+        return;
+
+    sim_slot_t *slot = sim_next_slot(dev);
+    slot->finished = true;
+    dev->stats.frames++;
+
+    if (dev->cfg.post_cb)
+        dev->cfg.post_cb(slot->trans);
+}
+
+static const rmt_sim_peer_t k_peer = {
+    .next_due = sim_next_due,
+    .fire     = sim_fire,
+};
+
+/* Run the clock until the head slot finished or
+   ticks ran out (portMAX_DELAY = as long as it takes) */
+static bool sim_wait_head(spi_device_handle_t dev, TickType_t ticks)
+{
+    sim_slot_t *head = &dev->slots[dev->head];
+    if (head->finished)
+        return true;
+
+    uint64_t now = rmt_sim_now_ns();
+    uint64_t limit = ticks == portMAX_DELAY
+                   ? head->done_ns
+                   : now + (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ULL;
+
+    if (head->done_ns < limit)
+        limit = head->done_ns;
+    if (limit > now)
+        rmt_sim_advance_ns(limit - now);
+
+    /* Due exactly now: nothing advanced the clock */
+    while (!head->finished && head->done_ns <= rmt_sim_now_ns())
+        sim_fire();
+
+    return head->finished;
+}
+
+/* =================================================
+   Bus
+==================================================*/
+esp_err_t spi_bus_initialize(spi_host_device_t host,
+                             const spi_bus_config_t *bus_config,
+                             spi_common_dma_t dma_chan)
+{
+    /* SPI1 belongs to the flash */
+    CHECK_ARG(host > SPI1_HOST && host < SPI_HOST_MAX);
+    CHECK_ARG(bus_config && bus_config->mosi_io_num >= 0);
+
+    sim_bus_t *bus = &s_buses[host];
+    if (bus->used)
+        return ESP_ERR_INVALID_STATE;
+
+    memset(bus, 0, sizeof(*bus));
+    bus->used = true;
+    bus->dma = dma_chan != SPI_DMA_DISABLED;
+    bus->max_transfer = !bus->dma ? SIM_FIFO_BYTES
+                      : bus_config->max_transfer_sz > 0 ? (size_t)bus_config->max_transfer_sz
+                      : SIM_MAX_TRANSFER;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host)
+{
+    CHECK_ARG(host > SPI1_HOST && host < SPI_HOST_MAX);
+
+    sim_bus_t *bus = &s_buses[host];
+    if (!bus->used)
+        return ESP_ERR_INVALID_STATE;
+
+    for (int d = 0; d < SIM_DEVS_PER_BUS; d++) {
+        if (bus->devs[d])
+            return ESP_ERR_INVALID_STATE;
+    }
+
+    bus->used = false;
+    return ESP_OK;
+}
+
+/* =================================================
+   Device
+==================================================*/
+esp_err_t spi_bus_add_device(spi_host_device_t host,
+                             const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle)
+{
+    CHECK_ARG(host > SPI1_HOST && host < SPI_HOST_MAX);
+    CHECK_ARG(dev_config && handle);
+    CHECK_ARG(dev_config->clock_speed_hz > 0 && dev_config->queue_size > 0);
+
+    sim_bus_t *bus = &s_buses[host];
+    if (!bus->used)
+        return ESP_ERR_INVALID_STATE;
+
+    int slot = -1;
+    for (int d = 0; d < SIM_DEVS_PER_BUS; d++) {
+        if (!bus->devs[d]) {
+            slot = d;
+            break;
+        }
+    }
+    if (slot < 0)
+        return ESP_ERR_NOT_FOUND;
+
+    spi_device_handle_t dev = calloc(1, sizeof(*dev));
+    if (!dev)
+        return ESP_ERR_NO_MEM;
+
+    dev->slots = calloc(dev_config->queue_size, sizeof(*dev->slots));
+    if (!dev->slots) {
+        free(dev);
+        return ESP_ERR_NO_MEM;
+    }
+
+    dev->host = host;
+    dev->cfg = *dev_config;
+    bus->devs[slot] = dev;
+
+    rmt_sim_add_peer(&k_peer);
+
+    *handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+    CHECK_ARG(handle);
+
+    /* Every transaction has to be picked up first */
+    if (handle->count)
+        return ESP_ERR_INVALID_STATE;
+
+    sim_bus_t *bus = &s_buses[handle->host];
+    for (int d = 0; d < SIM_DEVS_PER_BUS; d++) {
+        if (bus->devs[d] == handle)
+            bus->devs[d] = NULL;
+    }
+
+    free(handle->slots);
+    free(handle->frame);
+    free(handle);
+    return ESP_OK;
+}
+
+/* =================================================
+   Transactions
+==================================================*/
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle,
+                                 spi_transaction_t *trans_desc,
+                                 TickType_t ticks_to_wait)
+{
+    spi_device_handle_t dev = handle;
+
+    CHECK_ARG(dev && trans_desc);
+    CHECK_ARG(trans_desc->tx_buffer || trans_desc->length == 0);
+
+    size_t bytes = (trans_desc->length + 7) / 8;
+    CHECK_ARG(bytes <= s_buses[dev->host].max_transfer);
+
+    /* Every slot taken: only a finished, unclaimed one
+       at the head would free up, and only the caller
+       can claim it */
+    if (dev->count == (size_t)dev->cfg.queue_size)
+        return ESP_ERR_TIMEOUT;
+
+    (void)ticks_to_wait;
+
+    if (bytes > dev->frame_cap) {
+        uint8_t *grown = realloc(dev->frame, bytes);
+        if (!grown)
+            return ESP_ERR_NO_MEM;
+
+        dev->frame = grown;
+        dev->frame_cap = bytes;
+    }
+    memcpy(dev->frame, trans_desc->tx_buffer, bytes);
+    dev->frame_len = bytes;
+
+    uint64_t now = rmt_sim_now_ns();
+    uint64_t wire_ns = (uint64_t)trans_desc->length * 1000000000ULL / dev->cfg.clock_speed_hz;
+    uint64_t start = dev->busy_until_ns > now ? dev->busy_until_ns : now;
+
+    dev->busy_until_ns = start + wire_ns;
+
+    sim_slot_t *slot = &dev->slots[(dev->head + dev->count) % dev->cfg.queue_size];
+    slot->trans = trans_desc;
+    slot->done_ns = dev->busy_until_ns;
+    slot->finished = false;
+    dev->count++;
+
+    dev->stats.bytes += bytes;
+    dev->stats.wire_ns += wire_ns;
+    dev->stats.last_wire_ns = wire_ns;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle,
+                                      spi_transaction_t **trans_desc,
+                                      TickType_t ticks_to_wait)
+{
+    spi_device_handle_t dev = handle;
+
+    CHECK_ARG(dev && trans_desc);
+
+    /* Nothing queued: the driver would block until the timeout */
+    if (dev->count == 0) {
+        if (ticks_to_wait != portMAX_DELAY)
+            rmt_sim_advance_ns((uint64_t)ticks_to_wait * portTICK_PERIOD_MS * 1000000ULL);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    if (!sim_wait_head(dev, ticks_to_wait))
+        return ESP_ERR_TIMEOUT;
+
+    *trans_desc = dev->slots[dev->head].trans;
+    dev->head = (dev->head + 1) % dev->cfg.queue_size;
+    dev->count--;
+    return ESP_OK;
+}
+
+/* =================================================
+   Inspection
+==================================================*/
+esp_err_t spi_sim_get_stats(spi_device_handle_t device, spi_sim_stats_t *out)
+{
+    CHECK_ARG(device && out);
+    *out = device->stats;
+    return ESP_OK;
+}
+
+const uint8_t *spi_sim_last_frame(spi_device_handle_t device, size_t *num_bytes)
+{
+    if (!device) {
+        if (num_bytes)
+            *num_bytes = 0;
+        return NULL;
+    }
+
+    if (num_bytes)
+        *num_bytes = device->frame_len;
+    return device->frame;
+}
+
+size_t spi_sim_decode_bytes(const uint8_t *mosi,
+                            size_t num_bytes,
+                            unsigned bits_per_bit,
+                            uint8_t *out,
+                            size_t out_size)
+{
+    size_t total_bits = num_bytes * 8;
+    size_t pos = 0;
+    size_t n = 0;
+
+    if (bits_per_bit == 0)
+        return 0;
+
+    while (n < out_size && pos + 8 * bits_per_bit <= total_bits) {
+        uint8_t b = 0;
+
+        for (int k = 0; k < 8; k++) {
+            unsigned high = 0;
+
+            for (unsigned j = 0; j < bits_per_bit; j++, pos++) {
+                unsigned bit = (mosi[pos / 8] >> (7 - pos % 8)) & 1;
+                if (j == 0 && !bit)
+                    return n;
+                high += bit;
+            }
+
+            b = (uint8_t)(b << 1) | (2 * high >= bits_per_bit);
+        }
+
+        out[n++] = b;
+    }
+
+    return n;
+}
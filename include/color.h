@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -25,6 +26,16 @@ typedef struct {
     uint8_t w;
 } rgbw_t;
 
+// --------------------------------------------------
+// 16-bit linear RGB (PART 14)
+// - 0..65535 per channel, linear light
+// --------------------------------------------------
+typedef struct {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} rgb16_t;
+
 // --------------------------------------------------
 // Predefined colors (flash-resident, defined in color.c)
 // --------------------------------------------------
@@ -75,16 +86,116 @@ static inline rgbw_t rgb_to_rgbw(rgb_t c)
     return out;
 }
 
-// Convert RGBW ? RGB (for non-RGBW strips)
+// Saturating a + b (no wrap past 255)
+static inline uint8_t color_add_sat(uint8_t a, uint8_t b)
+{
+    uint16_t s = (uint16_t)a + b;
+    return (uint8_t)(s | (uint8_t)-(s >> 8));
+}
+
+// Convert RGBW ? RGB (for non-RGBW strips, saturating)
 static inline rgb_t rgbw_to_rgb(rgbw_t c)
 {
     rgb_t out;
-    out.r = c.r + c.w;
-    out.g = c.g + c.w;
-    out.b = c.b + c.w;
+    out.r = color_add_sat(c.r, c.w);
+    out.g = color_add_sat(c.g, c.w);
+    out.b = color_add_sat(c.b, c.w);
     return out;
 }
 
+// Span versions (defined in color.c)
+// - src / dst must not overlap
+void rgb_to_rgbw_span(const rgb_t *src, rgbw_t *dst, size_t count);
+void rgbw_to_rgb_span(const rgbw_t *src, rgb_t *dst, size_t count);
+
+// --------------------------------------------------
+// HSV (Part 18)
+// - Integer only, no float / divide on hsv -> rgb
+// - h: 0..255 = one turn (hsv_t), or 0..65535 for
+//   the 16-bit hue entry point (smooth sweeps)
+// - s, v: 0..255
+// --------------------------------------------------
+typedef struct {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+} hsv_t;
+
+// Hexcone: each channel sits at v within one sector
+// of its own hue (R 0, G 1/3, B 2/3 turn), ramps
+// down over the next sector, and floors at v*(1-s).
+// Position is measured in 1536ths of a turn.
+static inline uint8_t hsv_channel(int32_t d, uint8_t lo, uint8_t hi)
+{
+    // d is in [-1024, 1536): wrap to [-768, 768), take |d|
+    if (d >= 768)  d -= 1536;
+    if (d < -768)  d += 1536;
+    if (d < 0)     d = -d;
+
+    // 256 = full within a sector, 0 beyond two
+    int32_t k = 512 - d;
+    if (k > 256) k = 256;
+    if (k < 0)   k = 0;
+
+    return (uint8_t)(lo + (((uint32_t)(hi - lo) * (uint32_t)k) >> 8));
+}
+
+static inline rgb_t hsv16_to_rgb(uint16_t h, uint8_t s, uint8_t v)
+{
+    int32_t h6 = (int32_t)(((uint32_t)h * 6) >> 8);   // 0..1535
+
+    // lo = v * (255 - s) / 255, exact
+    uint32_t x = (uint32_t)v * (255u - s);
+    uint8_t lo = (uint8_t)((x + 1 + (x >> 8)) >> 8);
+
+    rgb_t out;
+    out.r = hsv_channel(h6,        lo, v);
+    out.g = hsv_channel(h6 - 512,  lo, v);
+    out.b = hsv_channel(h6 - 1024, lo, v);
+    return out;
+}
+
+static inline rgb_t hsv_to_rgb(hsv_t c)
+{
+    return hsv16_to_rgb((uint16_t)(c.h << 8), c.s, c.v);
+}
+
+// Inverse (one divide for s, one for h)
+static inline hsv_t rgb_to_hsv(rgb_t c)
+{
+    uint8_t max = c.r > c.g ? c.r : c.g;
+    uint8_t min = c.r < c.g ? c.r : c.g;
+    if (c.b > max) max = c.b;
+    if (c.b < min) min = c.b;
+
+    hsv_t out = { 0, 0, max };
+    int32_t delta = max - min;
+    if (delta == 0)
+        return out;
+
+    out.s = (uint8_t)((delta * 255 + max / 2) / max);
+
+    // Sector base + offset, in 1536ths of a turn
+    int32_t h6;
+    if (max == c.r)
+        h6 = ((int32_t)(c.g - c.b) * 256) / delta;
+    else if (max == c.g)
+        h6 = 512 + ((int32_t)(c.b - c.r) * 256) / delta;
+    else
+        h6 = 1024 + ((int32_t)(c.r - c.g) * 256) / delta;
+
+    if (h6 < 0)
+        h6 += 1536;
+
+    out.h = (uint8_t)(((uint32_t)h6 * 43691u) >> 18);   // / 6
+    return out;
+}
+
+// Span versions (defined in color.c)
+// - src / dst must not overlap
+void hsv_to_rgb_span(const hsv_t *src, rgb_t *dst, size_t count);
+void rgb_to_hsv_span(const rgb_t *src, hsv_t *dst, size_t count);
+
 // --------------------------------------------------
 // Gamma helpers (Part 6)
 // --------------------------------------------------
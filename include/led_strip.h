@@ -6,8 +6,12 @@
 
 #include "driver/gpio.h"
 #include "driver/rmt_tx.h"
+#include "driver/spi_master.h"
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "color.h"
+#include "led_strip_stats.h"
 
 /*
     PUBLIC API = helper layer
@@ -31,14 +35,65 @@ typedef enum {
 } led_strip_type_t;
 
 // ==================================================
-// RGB byte order
+// RGB byte order (wire order, first byte first)
 // ==================================================
 typedef enum {
     LED_ORDER_GRB = 0,
     LED_ORDER_RGB,
-    LED_ORDER_BRG
+    LED_ORDER_BRG,
+    LED_ORDER_RBG,
+    LED_ORDER_GBR,
+    LED_ORDER_BGR
 } led_strip_order_t;
 
+// ==================================================
+// PART 9: frame pipeline depth
+// 0/1 = single buffer, 2 = double, 3 = triple
+// ==================================================
+#define LED_STRIP_MAX_BUFFERS 3
+
+// ==================================================
+// PART 23: RMT channel resources (set before init)
+// - mem_block_symbols: channel symbol memory (or DMA
+//   buffer); the driver refills one half while the
+//   other half is on the wire, so a refill interrupt
+//   fires every mem_block_symbols / 2 bits
+// - all 0 = 64 symbols (1024 with DMA), queue depth 4,
+//   default interrupt priority; init writes back the
+//   values in use
+// ==================================================
+#define LED_STRIP_MAX_QUEUE 8
+
+typedef struct {
+    size_t   mem_block_symbols;   // even; 0 = default
+    size_t   trans_queue_depth;   // 1..LED_STRIP_MAX_QUEUE, 0 = 4
+    int      intr_priority;       // 0 = driver default, else 1..3
+    struct {
+        uint32_t with_dma : 1;    // DMA-backed channel (not on every target)
+    } flags;
+} led_strip_rmt_config_t;
+
+// ==================================================
+// PART 24: output backend (set before init)
+// ==================================================
+typedef enum {
+    LED_STRIP_BACKEND_RMT = 0,
+    LED_STRIP_BACKEND_SPI,     // MOSI of a whole SPI bus, DMA
+} led_strip_backend_t;
+
+// ==================================================
+// Encode kernel: logical pixels [first, first + count)
+// of frame -> wire bytes (picked by the core at init
+// and again when the color settings change)
+// ==================================================
+typedef void (*led_strip_stage_fn_t)(
+    const struct led_strip_t *strip,
+    const uint8_t *frame,
+    size_t first,
+    size_t count,
+    uint8_t *dst
+);
+
 // ==================================================
 // Strip descriptor (shared between core + helper)
 // ==================================================
@@ -48,22 +103,140 @@ typedef struct led_strip_t {
     led_strip_order_t     order;
 
     // Brightness (0?255) ? helper applies
+    // 0 at init = full brightness
     uint8_t               brightness;
 
-    // PART 8: RGBW support
+    // PART 11: per-strip color pipeline
+    // - white_balance: per-channel gain (255 = unity, all 0 at init = unity)
+    // - gamma_curve / correction / temperature_k: const
+    //   table selections (led_strip_tables.h), 0 = 2.2 /
+    //   none / off
+    // - color_gain: balance x correction x temperature,
+    //   set with the LUT
+    // - lut: gamma x brightness x color_gain, indexed [r,g,b,w][value]
+    //   (w = gamma x brightness) rebuilt by the helper setters
+    //   only, read by the encoder
+    bool                  gamma_enabled;
+    uint8_t               gamma_curve;      // led_gamma_t
+    uint8_t               correction;       // led_correction_t
+    uint16_t              temperature_k;
+    rgb_t                 white_balance;
+    rgb_t                 color_gain;
+    uint8_t               lut[4][256];
+
+    // PART 8: RGBW support (set before init, implied by SK6812)
+    // - buf holds R,G,B,W (4 bytes per pixel), wire order
+    //   is the RGB order followed by W
+    // - RGB writes leave W at 0
     bool                  is_rgbw;
 
     size_t                length;
     gpio_num_t            gpio;
+    led_strip_rmt_config_t rmt;           // PART 23
+
+    // PART 24: SPI backend (backend = SPI, set before init)
+    // - the strip owns the whole bus: MOSI = gpio, no
+    //   clock / CS pin, so one strip per SPI host
+    // - every wire byte expands to 4 SPI bytes through a
+    //   const 256-entry table into spi_buf (DMA), followed
+    //   by the latch as zero bytes
+    // - one frame in flight: the next submit waits for it
+    led_strip_backend_t   backend;
+    spi_host_device_t     spi_host;
+    spi_device_handle_t   spi;
+    uint32_t             *spi_buf;
+    size_t                spi_latch;      // latch bytes after the data
+    const uint32_t       *spi_table;      // wire byte -> 4 SPI bytes
+    spi_transaction_t     spi_trans;
+    bool                  spi_pending;    // spi_trans not collected yet
 
     // --- RMT core handles ---
     rmt_channel_handle_t  channel;
     rmt_encoder_handle_t  bytes_encoder;
-    rmt_encoder_handle_t  reset_encoder;
-    rmt_encoder_handle_t  composite_encoder;
+    rmt_encoder_handle_t  reset_encoder;   // copy encoder, latch symbols
+    rmt_encoder_handle_t  pixel_encoder;   // LUT + order + latch, per frame
+    led_strip_stage_fn_t  stage;           // kernel for format / order / LUT
+
+    // Logical pixel buffer (R,G,B[,W], unscaled)
+    uint8_t              *buf;   // length * bpp bytes
+    uint8_t               bpp;   // bytes per logical pixel (set by init)
+
+    // PART 14: 16-bit linear frame buffer (set before init)
+    // - buf holds rgb16_t, 8-bit writes are expanded (v * 257)
+    // - encoder scales in fixed point and quantizes to 8 bits
+    //   with temporal error diffusion (residual per channel)
+    // - every refresh sends the whole strip (dither moves)
+    bool                  linear16;
+    uint8_t              *dither_err;    // length * 3 residuals
+    uint32_t              gain_q16[3];   // brightness x balance, max 65280
+    const uint16_t       *gamma16;       // 257-entry curve, NULL = off
+
+    // PART 22: palette-indexed frame buffer (set before init)
+    // - palette_bits 8 / 4: buf holds one index per pixel
+    //   (4-bit: two per byte, even pixel in the low nibble),
+    //   RGB writes are rejected (not with RGBW / 16-bit)
+    // - palette: 1 << palette_bits logical colors
+    // - palette_lut: the same through the LUT, read by the
+    //   encoder; rebuilt per entry / with the LUT
+    uint8_t               palette_bits;
+    rgb_t                *palette;
+    rgb_t                *palette_lut;
+
+    // PART 9: multi-buffer pipeline
+    // - buf always points at the back (render) buffer
+    // - refresh_async hands buf to RMT and moves buf to
+    //   the next buffer once its previous frame is out
+    uint8_t               buffer_count;   // set before init
+    uint8_t               render_index;
+    uint8_t              *frames[LED_STRIP_MAX_BUFFERS];
+    SemaphoreHandle_t     frames_free;    // given by on_trans_done
 
-    // Raw pixel buffer (GRB, unscaled)
-    uint8_t              *buf;   // length * 3 bytes
+    // PART 12: dirty tracking
+    // [dirty_start, dirty_end) changed since the last refresh,
+    // dirty_end == 0 -> clean (refresh is a no-op)
+    size_t                dirty_start;
+    size_t                dirty_end;
+
+    // PART 20: power budget (helper layer)
+    // - power_budget_ma: 0 = no limit
+    // - power_scale: multiplies brightness in the LUT for
+    //   frames over budget (255 = not limited)
+    // - power_blocks: per 32-pixel block channel sums
+    //   (gamma applied, before brightness / balance),
+    //   refreshed over [power_lo, power_hi) only = pixels
+    //   changed since the last estimate, power_hi == 0 -> none
+    uint32_t              power_budget_ma;
+    uint16_t              power_channel_ma;  // one channel at 255 (both 0 at init = 20 mA,
+    uint16_t              power_idle_ua;     // idle per pixel          1000 uA)
+    uint8_t               power_scale;
+    uint16_t            (*power_blocks)[4];
+    uint32_t              power_sum[4];
+    size_t                power_lo;
+    size_t                power_hi;
+
+    // PART 13: completion tracking
+    // submitted is written by the task, done by the TX ISR;
+    // frames still on the wire = submitted - done
+    volatile uint32_t     tx_submitted;
+    volatile uint32_t     tx_done;
+    led_strip_done_cb_t   on_done;        // optional, ISR context
+    void                 *done_ctx;
+
+#if LED_STRIP_STATS
+    // PART 16: instrumentation (see led_strip_stats.h)
+    // - write / encode cycles accumulate until the frame
+    //   is submitted / fully encoded
+    // - submit_us indexed by tx counter % 2 x MAX_QUEUE
+    //   (more than the RMT queue can hold in flight)
+    // - refill_cycles: encoder time in refill interrupts
+    //   (every call after the first fill) of the frame
+    led_strip_stats_t     stats;
+    uint32_t              write_cycles;
+    uint32_t              encode_cycles;
+    uint32_t              refill_cycles;
+    int64_t               submit_us[2 * LED_STRIP_MAX_QUEUE];
+    int64_t               last_done_us;
+#endif
 } led_strip_t;
 
 /* ==================================================
@@ -75,11 +248,24 @@ typedef struct led_strip_t {
 esp_err_t led_strip_core_init(led_strip_t *strip);
 esp_err_t led_strip_core_free(led_strip_t *strip);
 esp_err_t led_strip_core_refresh(led_strip_t *strip);
+esp_err_t led_strip_core_refresh_async(led_strip_t *strip);
+esp_err_t led_strip_core_submit(led_strip_t *strip, bool force);
+esp_err_t led_strip_core_abort(led_strip_t *strip);
+bool      led_strip_core_is_busy(led_strip_t *strip);
 esp_err_t led_strip_core_set_pixel(
     led_strip_t *strip,
     size_t index,
     rgb_t color
 );
+esp_err_t led_strip_core_set_pixel_rgbw(
+    led_strip_t *strip,
+    size_t index,
+    rgbw_t color
+);
+void      led_strip_core_mark_dirty(led_strip_t *strip, size_t start, size_t count);
+void      led_strip_core_select_kernel(led_strip_t *strip);
+esp_err_t led_strip_core_wait(led_strip_t *strip, int timeout_ms);
+esp_err_t led_strip_core_rmt_load(const led_strip_t *strip, led_strip_rmt_load_t *out);
 
 #ifdef __cplusplus
 }
@@ -7,6 +7,7 @@
 
 #include "driver/gpio.h"
 #include "driver/rmt_tx.h"
+#include "driver/spi_master.h"
 #include "esp_err.h"
 #include "color.h"
 
@@ -17,9 +18,11 @@ extern "C" {
 /*
     LED STRIP CORE (PRIVATE)
 
-    - Hardware-only RMT TX driver
-    - No brightness logic
-    - No color order logic
+    - Hardware-only RMT TX driver (SPI + DMA as an
+      alternative output, led_strip_spi.c)
+    - Frame buffer holds logical (R,G,B[,W]) values
+    - Helper builds the color LUT; the pixel encoder
+      applies it + color order while encoding
     - No public API exposure
 */
 
@@ -32,6 +35,50 @@ typedef struct led_strip_t led_strip_t;
 esp_err_t led_strip_core_init(led_strip_t *strip);
 esp_err_t led_strip_core_free(led_strip_t *strip);
 
+/* -------------------------------------------------
+   Pixel encoder (led_strip_encoder.c)
+--------------------------------------------------*/
+/* Needs strip->bytes_encoder + strip->reset_encoder (copy);
+   reset_ticks of low level end every frame */
+esp_err_t led_strip_core_new_encoder(
+    led_strip_t *strip,
+    size_t mem_block_symbols,
+    uint32_t reset_ticks,
+    rmt_encoder_handle_t *ret_encoder
+);
+
+/* Point strip->stage at the kernel matching its
+   order, pixel format and color settings */
+void led_strip_core_select_kernel(led_strip_t *strip);
+
+/* Logical pixels [first, first + count) of frame ->
+   count * 3 (RGBW: 4) wire bytes (color transform + order) */
+void led_strip_core_stage_pixels(
+    const led_strip_t *strip,
+    const uint8_t *frame,
+    size_t first,
+    size_t count,
+    uint8_t *dst
+);
+
+/* -------------------------------------------------
+   SPI backend (led_strip_spi.c)
+--------------------------------------------------*/
+/* Bus + device on strip->spi_host, DMA buffer for the
+   whole strip; reset_us of low level end every frame */
+esp_err_t led_strip_spi_init(led_strip_t *strip, uint32_t reset_us);
+esp_err_t led_strip_spi_free(led_strip_t *strip);
+
+/* Stage + expand pixels [0, pixels) and queue them;
+   waits for the previous frame first */
+esp_err_t led_strip_spi_transmit(led_strip_t *strip, size_t pixels);
+esp_err_t led_strip_spi_wait(led_strip_t *strip, int timeout_ms);
+
+/* Frame fully on the wire (ISR context, any backend):
+   counters, free buffer, user callback.
+   Returns true if a higher priority task woke */
+bool led_strip_core_frame_done(led_strip_t *strip);
+
 /* -------------------------------------------------
    Core output
 --------------------------------------------------*/
@@ -41,6 +88,19 @@ esp_err_t led_strip_core_refresh(led_strip_t *strip);
 esp_err_t led_strip_core_refresh_async(led_strip_t *strip);
 bool      led_strip_core_is_busy(led_strip_t *strip);
 
+/* Wait for every queued frame (timeout_ms < 0 = forever),
+   time spent blocked goes into the wait histogram */
+esp_err_t led_strip_core_wait(led_strip_t *strip, int timeout_ms);
+
+/* Queue the dirty prefix without waiting.
+   force = send pixel 0 even if the frame is clean */
+esp_err_t led_strip_core_submit(led_strip_t *strip, bool force);
+
+/* Drop frames queued but never started (RMT, sync
+   round that will not start): channel cycled, counters
+   and buffers rolled back, whole strip dirty again */
+esp_err_t led_strip_core_abort(led_strip_t *strip);
+
 /* -------------------------------------------------
    Core pixel write (RAW BYTES)
 --------------------------------------------------*/
@@ -50,6 +110,17 @@ esp_err_t led_strip_core_set_pixel(
     rgb_t color
 );
 
+esp_err_t led_strip_core_set_pixel_rgbw(
+    led_strip_t *strip,
+    size_t index,
+    rgbw_t color
+);
+
+/* -------------------------------------------------
+   Dirty tracking (anyone writing buf directly)
+--------------------------------------------------*/
+void led_strip_core_mark_dirty(led_strip_t *strip, size_t start, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
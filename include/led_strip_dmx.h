@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "led_strip.h"
+#include "led_strip_group.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 26 ? DMX-over-IP ingestion (E1.31 / Art-Net)
+//
+// - Parses one UDP payload from a caller buffer (no
+//   socket code here: feed it from a UDP task, a
+//   capture file or a loopback test)
+// - Universes map onto strip ranges; the DMX slots are
+//   span-written straight from the packet into the
+//   strip buffer (R,G,B[,W] or one palette index per
+//   pixel), the encoder applies order / LUT as usual
+// - Sync: E1.31 sync packets (for sync_universe) and
+//   ArtSync refresh every strip written since the last
+//   refresh at once (the group, when one is given)
+// - Art-Net data counts as synced while ArtSync keeps
+//   coming: after LED_DMX_ARTNET_SYNC_MS without one
+//   it is immediate (DATA) again, as Art-Net 4 asks
+// - Without sync the caller refreshes, e.g. after every
+//   DATA result or at its own frame rate
+// - E1.31 packets out of sequence, preview data and
+//   terminated streams are dropped
+// ==================================================
+
+#define LED_DMX_MAX_MAPS    16
+#define LED_DMX_SLOTS       512
+
+#define LED_DMX_E131_PORT   5568
+#define LED_DMX_ARTNET_PORT 6454
+
+#define LED_DMX_ARTNET_SYNC_MS 4000
+
+typedef struct {
+    uint16_t     universe;  // E1.31 universe / Art-Net port address
+    uint16_t     slot;      // first DMX slot used, 0-based
+    led_strip_t *strip;
+    size_t       start;     // first strip pixel
+    size_t       count;     // pixels, 0 = as many as the universe holds
+} led_dmx_map_t;
+
+typedef enum {
+    LED_DMX_IGNORED = 0,    // not for us / malformed / dropped
+    LED_DMX_DATA,           // pixels written, no refresh
+    LED_DMX_DATA_SYNCED,    // pixels written, shown by the next sync
+    LED_DMX_SYNC,           // sync packet: written strips refreshed
+} led_dmx_result_t;
+
+typedef struct {
+    led_dmx_map_t      maps[LED_DMX_MAX_MAPS];
+    size_t             count;
+    led_strip_group_t *group;           // refresh target, NULL = each strip
+    uint16_t           sync_universe;   // E1.31 sync address, 0 = any
+
+    uint32_t           pending;         // bit i = maps[i] written since refresh
+    uint8_t            seq[LED_DMX_MAX_MAPS];
+    uint32_t           seq_valid;       // bit i = seq[i] seen
+    bool               artnet_sync;     // ArtSync seen: data waits for it
+    int64_t            artnet_sync_us;  // when the last one came (esp_timer)
+
+    // Counters
+    uint32_t           packets;         // DATA / DATA_SYNCED
+    uint32_t           syncs;
+    uint32_t           dropped;         // for us, but rejected
+} led_dmx_rx_t;
+
+// maps are copied; strips must be initialized and
+// outlive rx. group (optional) should hold them all.
+esp_err_t led_dmx_rx_init(
+    led_dmx_rx_t *rx,
+    const led_dmx_map_t *maps,
+    size_t count,
+    led_strip_group_t *group
+);
+
+led_dmx_result_t led_dmx_rx_ingest(led_dmx_rx_t *rx, const uint8_t *pkt, size_t len);
+
+// Refresh (async) what was written since the last refresh
+void led_dmx_rx_refresh(led_dmx_rx_t *rx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "color.h"
+#include "esp_err.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,7 +20,15 @@ typedef struct led_strip_t led_strip_t;
 void led_strip_init(led_strip_t *strip);
 void led_strip_free(led_strip_t *strip);
 
+// Sends only the prefix up to the last changed pixel,
+// no-op when nothing changed since the last refresh
 void led_strip_refresh(led_strip_t *strip);
+
+// Force the next refresh to resend the whole strip
+// (e.g. after the LED supply was power-cycled)
+void led_strip_invalidate(led_strip_t *strip);
+
+// Buffer only ? nothing goes on the wire until refresh
 void led_strip_clear(led_strip_t *strip);
 
 void led_strip_set_pixel(
@@ -28,21 +37,74 @@ void led_strip_set_pixel(
     rgb_t color
 );
 
+// Buffer only ? nothing goes on the wire until refresh
 void led_strip_fill(
     led_strip_t *strip,
     rgb_t color
 );
 
+// Fill [start, start + count), clipped to the strip
+void led_strip_fill_range(
+    led_strip_t *strip,
+    size_t start,
+    size_t count,
+    rgb_t color
+);
+
+// ==================================================
+// Brightness (software scaling, per strip)
+// - Applied while encoding: a change costs one LUT
+//   rebuild and a full resend, pixels stay untouched
+// ==================================================
+void    led_strip_set_brightness(led_strip_t *strip, uint8_t level); // 0?255
+uint8_t led_strip_get_brightness(const led_strip_t *strip);
+
 // ==================================================
-// Brightness (software scaling)
+// Part 6 ? Gamma correction (per strip)
+// - Curves are const tables generated at build time
+//   (led_strip_tables.h), nothing is computed at run
+//   time; 2.2 unless another curve is selected
+// - LED_GAMMA_CUSTOM: exponent set by the build
+//   (LED_STRIP_GAMMA_CUSTOM, default 2.0)
 // ==================================================
-void    led_strip_set_brightness(uint8_t level); // 0?255
-uint8_t led_strip_get_brightness(void);
+typedef enum {
+    LED_GAMMA_2_2 = 0,
+    LED_GAMMA_2_5,
+    LED_GAMMA_2_8,
+    LED_GAMMA_SRGB,         // piecewise sRGB decode
+    LED_GAMMA_CUSTOM,
+    LED_GAMMA_COUNT,
+} led_gamma_t;
+
+void led_strip_enable_gamma(led_strip_t *strip, bool enable);
+
+// Takes effect while gamma is enabled
+void led_strip_set_gamma_curve(led_strip_t *strip, led_gamma_t curve);
 
 // ==================================================
-// Part 6 ? Gamma correction
+// Part 11 ? White balance (per strip)
+// - Per-channel gain, 255 = unity
+// - Color correction (LED die imbalance) and color
+//   temperature are preset gains from the same const
+//   tables; all three multiply into the color LUT
 // ==================================================
-void led_strip_enable_gamma(bool enable);
+typedef enum {
+    LED_CORRECTION_NONE = 0,
+    LED_CORRECTION_SMD5050,         // typical 5050 strips
+    LED_CORRECTION_PIXEL_STRING,    // typical 8 / 12 mm pixels
+    LED_CORRECTION_COUNT,
+} led_correction_t;
+
+#define LED_TEMPERATURE_MIN     1000    // kelvin
+#define LED_TEMPERATURE_MAX     12000
+#define LED_TEMPERATURE_STEP    100
+#define LED_TEMPERATURE_STEPS   ((LED_TEMPERATURE_MAX - LED_TEMPERATURE_MIN) / LED_TEMPERATURE_STEP + 1)
+
+void led_strip_set_white_balance(led_strip_t *strip, rgb_t gain);
+void led_strip_set_color_correction(led_strip_t *strip, led_correction_t correction);
+
+// Nearest 100 K step, clamped to MIN..MAX; 0 = off
+void led_strip_set_color_temperature(led_strip_t *strip, uint16_t kelvin);
 
 // ==================================================
 // Part 7 ? Async / non-blocking refresh
@@ -50,8 +112,28 @@ void led_strip_enable_gamma(bool enable);
 void led_strip_refresh_async(led_strip_t *strip);
 bool led_strip_is_busy(led_strip_t *strip);
 
+// Frame done callback
+// - Runs in the RMT TX done ISR (keep it short, IRAM)
+//   once the frame and its latch are on the wire
+// - Return true if it woke a higher priority task
+//   (e.g. vTaskNotifyGiveFromISR to wake a render task)
+// - Set while the strip is idle (ESP_ERR_INVALID_STATE
+//   while a frame is in flight); NULL removes it
+typedef bool (*led_strip_done_cb_t)(led_strip_t *strip, void *ctx);
+
+esp_err_t led_strip_set_done_callback(
+    led_strip_t *strip,
+    led_strip_done_cb_t cb,
+    void *ctx
+);
+
 // ==================================================
 // Part 8 ? RGBW support
+// - Strips with is_rgbw (or type SK6812) keep 4 bytes
+//   per pixel and drive the white die directly
+// - RGB strips get W mixed into r,g,b (saturating)
+// - rgb_to_rgbw_span() in color.h splits white out
+//   of an RGB frame before writing it here
 // ==================================================
 void led_strip_set_pixel_rgbw(
     led_strip_t *strip,
@@ -59,6 +141,137 @@ void led_strip_set_pixel_rgbw(
     rgbw_t color
 );
 
+void led_strip_set_pixels_rgbw(
+    led_strip_t *strip,
+    size_t start,
+    const rgbw_t *src,
+    size_t count
+);
+
+// ==================================================
+// Part 10 ? Bulk span writes
+// - One bounds check per call (span clipped to strip)
+// - Same gamma / brightness / order as set_pixel
+// ==================================================
+void led_strip_set_pixels(
+    led_strip_t *strip,
+    size_t start,
+    const rgb_t *src,
+    size_t count
+);
+
+// rgb = count packed R,G,B byte triplets
+void led_strip_set_pixels_raw(
+    led_strip_t *strip,
+    size_t start,
+    const uint8_t *rgb,
+    size_t count
+);
+
+// ==================================================
+// Part 14 ? 16-bit linear writes
+// - Native on strips with linear16 set before init
+//   (quantized to 8 bits with temporal dithering,
+//   refresh every frame for the dither to average)
+// - Truncated to 8 bits on regular strips
+// ==================================================
+void led_strip_set_pixel16(
+    led_strip_t *strip,
+    size_t index,
+    rgb16_t color
+);
+
+void led_strip_set_pixels16(
+    led_strip_t *strip,
+    size_t start,
+    const rgb16_t *src,
+    size_t count
+);
+
+// ==================================================
+// Part 18 ? HSV span writes
+// - Integer conversion (hsv_to_rgb() in color.h),
+//   written straight into the strip buffer
+// - Same gamma / brightness / order as set_pixels
+// ==================================================
+void led_strip_set_pixels_hsv(
+    led_strip_t *strip,
+    size_t start,
+    const hsv_t *src,
+    size_t count
+);
+
+// ==================================================
+// Part 20 ? Power budget
+// - Estimated current = idle per pixel + channel_ma per
+//   channel at 255, after gamma / brightness / balance
+// - Estimate follows pixel writes: only pixels changed
+//   since the last refresh are re-summed
+// - A frame over budget is dimmed at encode time (folded
+//   into the brightness LUT), the buffer is not touched
+// - Groups can share one budget (led_strip_group.h)
+// ==================================================
+void     led_strip_set_power_budget(led_strip_t *strip, uint32_t budget_ma); // 0 = no limit
+void     led_strip_set_power_model(led_strip_t *strip, uint16_t channel_ma, uint16_t idle_ua);
+uint32_t led_strip_get_power_ma(led_strip_t *strip);           // current frame, before limiting
+uint8_t  led_strip_get_power_scale(const led_strip_t *strip);  // 255 = not limited
+
+// Called by the refresh paths: one scale for all strips
+// so their total stays under budget_ma (0 = only each
+// strip's own budget)
+void     led_strip_power_limit(led_strip_t *const *strips, size_t count, uint32_t budget_ma);
+
+// ==================================================
+// Part 22 ? Palette-indexed strips
+// - Set palette_bits (8 or 4) before init: the frame
+//   buffer holds one index per pixel (1 or 1/2 byte
+//   instead of 3), expanded while encoding
+// - RGB writes are ignored on palette strips;
+//   led_strip_clear() sets every pixel to index 0
+// - A palette change costs O(entries) plus one resend
+//   of the strip; pixels stay untouched
+// ==================================================
+void led_strip_set_palette(
+    led_strip_t *strip,
+    size_t first,
+    const rgb_t *colors,
+    size_t count
+);
+
+void led_strip_set_index(led_strip_t *strip, size_t index, uint8_t value);
+
+void led_strip_set_indices(
+    led_strip_t *strip,
+    size_t start,
+    const uint8_t *src,
+    size_t count
+);
+
+void led_strip_fill_index(led_strip_t *strip, size_t start, size_t count, uint8_t value);
+
+// ==================================================
+// Part 23 ? RMT refill load
+// - Long strips are sent in ping-pong halves of the
+//   channel memory (led_strip_t.rmt): every half that
+//   drains raises an interrupt that encodes the next
+//   one, and must run before the other half drains
+// - refills / refill_period_us follow from the
+//   configuration; isr_us is measured: mean encoder
+//   time spent in refill interrupts per frame
+// - measured = false (isr_us / isr_load_permille 0)
+//   without LED_STRIP_STATS or before the first frame
+// ==================================================
+typedef struct {
+    uint32_t frame_us;            // whole strip on the wire, latch included
+    uint32_t refills;             // refill interrupts per whole-strip frame
+    uint32_t refill_period_us;    // wire time of half a block = ISR deadline
+    bool     measured;            // isr_us / isr_load_permille are valid
+    uint32_t isr_us;              // measured, per frame
+    uint32_t isr_load_permille;   // isr_us / frame_us
+} led_strip_rmt_load_t;
+
+esp_err_t led_strip_get_rmt_load(const led_strip_t *strip, led_strip_rmt_load_t *out);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "led_strip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 17 ? Effects engine
+//
+// - Renders straight into the strip buffer (through
+//   a per-effect scratch row on RGBW / 16-bit strips)
+// - Integer only: 32-bit phase accumulators in Q8.8
+//   and const wave / hue / heat tables
+// - Incremental: each frame advances the phase and
+//   writes only what changed (chase moves its block
+//   edges, fade writes nothing while the color holds)
+// - Each effect owns a range of the strip; several
+//   effects on different ranges compose into one
+//   frame. An effect drawn over by another needs
+//   led_fx_restart() to repaint its whole range
+// ==================================================
+
+typedef enum {
+    LED_FX_RAINBOW = 0,
+    LED_FX_CHASE,
+    LED_FX_FADE,
+    LED_FX_TWINKLE,
+    LED_FX_FIRE,
+} led_fx_kind_t;
+
+typedef struct {
+    led_fx_kind_t kind;
+    size_t        start;        // range on the strip (clipped)
+    size_t        length;       // 0 = to the end of the strip
+
+    // Q8.8 step per frame: rainbow = hue steps,
+    // chase = pixels, fade = wave steps (256 = 1 of 256),
+    // twinkle / fire = unused
+    uint16_t      speed;
+
+    union {
+        struct {
+            uint16_t hue_step;  // Q8.8 hue steps per pixel
+        } rainbow;
+
+        struct {
+            uint16_t size;      // lit pixels per block
+            uint16_t gap;       // dark pixels between blocks
+            rgb_t    on;
+            rgb_t    off;
+        } chase;
+
+        struct {
+            rgb_t    from;
+            rgb_t    to;
+        } fade;
+
+        struct {
+            uint16_t spawn;     // new sparkles per frame per 1000 px
+            uint8_t  decay;     // level *= decay / 256 per frame
+        } twinkle;
+
+        struct {
+            uint8_t  cooling;   // 20..100, higher = shorter flames
+            uint8_t  sparking;  // 50..200, chance of a new spark
+        } fire;
+    };
+} led_fx_config_t;
+
+typedef struct {
+    led_fx_config_t cfg;
+    uint32_t        phase;      // Q8.8 accumulator
+    uint32_t        rng;        // xorshift32 state
+    uint32_t        last;       // effect-specific previous position
+    bool            full;       // next frame repaints the whole range
+    uint8_t        *state;      // twinkle: level + hue, fire: heat
+    rgb_t          *scratch;    // non-RGB strips only
+} led_fx_t;
+
+// Allocates per-effect state (twinkle / fire, scratch
+// row on RGBW and 16-bit strips); strip must be initialized
+esp_err_t led_fx_init(led_fx_t *fx, const led_strip_t *strip, const led_fx_config_t *config);
+void      led_fx_free(led_fx_t *fx);
+
+// Repaint the whole range on the next frame
+void led_fx_restart(led_fx_t *fx);
+
+// Advance one frame and write it into the strip buffer
+// (no refresh). Effects render in array order.
+void led_fx_render(led_strip_t *strip, led_fx_t *fx);
+void led_fx_render_all(led_strip_t *strip, led_fx_t *fx, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driver/rmt_tx.h"
+#include "esp_err.h"
+#include "led_strip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 13 ? Synchronized multi-strip output
+//
+// - Every member strip starts on the same RMT tick
+//   (hardware sync manager), one wait for all
+// - Members must be led_strip_init()ed first and
+//   keep their own buffers / brightness / LUT
+// - Clean members still send pixel 0 so the sync
+//   round can start; nothing is sent if all are clean
+// ==================================================
+
+#define LED_STRIP_GROUP_MAX 8   // = TX channels on ESP32
+
+typedef struct {
+    led_strip_t               *strips[LED_STRIP_GROUP_MAX];
+    size_t                     count;
+    rmt_sync_manager_handle_t  sync;
+    uint32_t                   power_budget_ma;   // shared, 0 = none
+} led_strip_group_t;
+
+esp_err_t led_strip_group_init(
+    led_strip_group_t *group,
+    led_strip_t *const *strips,
+    size_t count
+);
+void led_strip_group_free(led_strip_group_t *group);
+
+// Start all members, then wait for all + reset latch
+esp_err_t led_strip_group_refresh(led_strip_group_t *group);
+
+// Start all members, return immediately.
+// A member that fails to submit aborts the round: the
+// others' frames are dropped (resent whole next time)
+// and its error is returned
+esp_err_t led_strip_group_refresh_async(led_strip_group_t *group);
+
+// true once every member's frames are out
+// (timeout_ms < 0 = wait forever; one deadline for
+// the whole group, not per member)
+bool led_strip_group_wait(led_strip_group_t *group, int timeout_ms);
+
+// Bit i set = strips[i] has nothing left on the wire
+uint32_t led_strip_group_done_mask(const led_strip_group_t *group);
+
+// Part 20: one budget for all members together (each
+// member's own budget still applies), 0 = none
+void led_strip_group_set_power_budget(led_strip_group_t *group, uint32_t budget_ma);
+
+#ifdef __cplusplus
+}
+#endif
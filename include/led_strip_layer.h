@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "led_strip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 19 ? Layer compositor
+//
+// - A stack of rgb_t layers, bottom first, composited
+//   over black into the strip buffer in one pass
+//   (through a scratch row on RGBW / 16-bit strips)
+// - Each layer covers a range of the strip and blends
+//   with what is below it, scaled by its opacity;
+//   pixels outside every layer are left untouched
+// - Kernels work on packed 32-bit words, two channels
+//   per 16-bit lane
+// - Incremental: only the union of the layers' dirty
+//   ranges is recomposited; a stack with no changes
+//   costs one check per layer and leaves the strip clean
+// ==================================================
+
+typedef enum {
+    LED_BLEND_ALPHA = 0,    // below + (layer - below) * opacity
+    LED_BLEND_ADD,          // below + layer * opacity, saturating
+    LED_BLEND_MULTIPLY,     // below * lerp(white, layer, opacity)
+    LED_BLEND_MAX,          // max(below, layer * opacity)
+} led_blend_t;
+
+typedef struct {
+    size_t      start;      // range on the strip (clipped)
+    size_t      length;     // 0 = to the end of the strip
+    led_blend_t mode;
+    uint8_t     opacity;    // 0 = hidden, 255 = full
+} led_layer_config_t;
+
+typedef struct {
+    led_layer_config_t cfg;
+    rgb_t             *pixels;      // cfg.length pixels, layer-relative
+
+    // [dirty_start, dirty_end) changed since the last
+    // render (layer-relative), dirty_end == 0 -> clean
+    size_t             dirty_start;
+    size_t             dirty_end;
+} led_layer_t;
+
+typedef struct {
+    led_layer_t *layers;    // bottom first, owned by the caller
+    size_t       count;
+    rgb_t       *row;       // non-RGB strips only
+} led_layer_stack_t;
+
+// Allocates the layer's pixels (black); strip must be initialized
+esp_err_t led_layer_init(led_layer_t *layer, const led_strip_t *strip, const led_layer_config_t *config);
+void      led_layer_free(led_layer_t *layer);
+
+// Layer writes (layer-relative index, clipped to the layer)
+void led_layer_set_pixel(led_layer_t *layer, size_t index, rgb_t color);
+void led_layer_set_pixels(led_layer_t *layer, size_t start, const rgb_t *src, size_t count);
+void led_layer_fill(led_layer_t *layer, size_t start, size_t count, rgb_t color);
+
+// After writing layer->pixels directly
+void led_layer_mark_dirty(led_layer_t *layer, size_t start, size_t count);
+
+// Mode / opacity changes recomposite the whole layer
+void led_layer_set_opacity(led_layer_t *layer, uint8_t opacity);
+void led_layer_set_mode(led_layer_t *layer, led_blend_t mode);
+
+// layers stay owned by the caller and must outlive the stack
+esp_err_t led_layer_stack_init(
+    led_layer_stack_t *stack,
+    const led_strip_t *strip,
+    led_layer_t *layers,
+    size_t count
+);
+void      led_layer_stack_free(led_layer_stack_t *stack);
+
+// Composite the changed ranges into the strip buffer (no refresh)
+void led_layer_stack_render(led_strip_t *strip, led_layer_stack_t *stack);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "led_strip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 21 ? Segments + 2D matrix mapping
+//
+// - Segment: zero-copy view of a strip range
+//   (offset, length, optionally reversed); writes go
+//   straight to the strip with segment-relative indices
+// - Matrix: width x height panel on a strip range. The
+//   layout is compiled into a flat index table at init,
+//   so mapping (x, y) is one load
+// - Rows that land on consecutive strip pixels (either
+//   direction) are written as spans: rectangle fill and
+//   blit cost one span call per row on row-major and
+//   serpentine panels, custom layouts fall back to
+//   per-pixel writes for scattered rows
+// ==================================================
+
+#define LED_MATRIX_UNMAPPED 0xFFFFu     // custom map: no LED here
+
+// --------------------------------------------------
+// Segments
+// --------------------------------------------------
+typedef struct {
+    led_strip_t *strip;
+    size_t       offset;
+    size_t       length;
+    bool         reverse;   // index 0 = last pixel of the range
+} led_segment_t;
+
+// length 0 = to the end of the strip (clipped)
+esp_err_t led_segment_init(
+    led_segment_t *seg,
+    led_strip_t *strip,
+    size_t offset,
+    size_t length,
+    bool reverse
+);
+
+void led_segment_set_pixel(led_segment_t *seg, size_t index, rgb_t color);
+void led_segment_set_pixels(led_segment_t *seg, size_t start, const rgb_t *src, size_t count);
+void led_segment_fill_range(led_segment_t *seg, size_t start, size_t count, rgb_t color);
+void led_segment_fill(led_segment_t *seg, rgb_t color);
+
+// --------------------------------------------------
+// Matrix
+// --------------------------------------------------
+typedef enum {
+    LED_MATRIX_ROW_MAJOR = 0,   // every row left to right
+    LED_MATRIX_SERPENTINE,      // odd rows right to left
+    LED_MATRIX_CUSTOM,          // map() below
+} led_matrix_layout_t;
+
+// Strip index of (x, y) relative to offset, or LED_MATRIX_UNMAPPED
+typedef uint16_t (*led_matrix_map_fn_t)(uint16_t x, uint16_t y, void *ctx);
+
+typedef struct {
+    uint16_t             width;
+    uint16_t             height;
+    size_t               offset;    // first matrix pixel on the strip
+    led_matrix_layout_t  layout;
+    led_matrix_map_fn_t  map;       // LED_MATRIX_CUSTOM only, called at init
+    void                *map_ctx;
+} led_matrix_config_t;
+
+typedef struct {
+    led_strip_t *strip;
+    uint16_t     width;
+    uint16_t     height;
+    uint16_t    *index;     // [y * width + x] -> strip index
+    int8_t      *row_step;  // +1 / -1 = row is a span, 0 = scattered
+} led_matrix_t;
+
+// Builds the index table; every mapped pixel must fit the
+// strip (ESP_ERR_INVALID_SIZE otherwise)
+esp_err_t led_matrix_init(led_matrix_t *m, led_strip_t *strip, const led_matrix_config_t *config);
+void      led_matrix_free(led_matrix_t *m);
+
+static inline size_t led_matrix_index(const led_matrix_t *m, uint16_t x, uint16_t y)
+{
+    return m->index[(size_t)y * m->width + x];
+}
+
+// Out-of-range coordinates are ignored / clipped
+void led_matrix_set_pixel(led_matrix_t *m, uint16_t x, uint16_t y, rgb_t color);
+
+void led_matrix_fill_rect(
+    led_matrix_t *m,
+    int x,
+    int y,
+    int w,
+    int h,
+    rgb_t color
+);
+
+// src = w x h pixels, row after row, stride in pixels
+void led_matrix_blit(
+    led_matrix_t *m,
+    int x,
+    int y,
+    const rgb_t *src,
+    int w,
+    int h,
+    size_t stride
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "esp_err.h"
+#include "led_strip.h"
+#include "led_strip_group.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 25 ? Lock-free frame queue (one producer,
+// one consumer, any two tasks / cores)
+//
+// - Three preallocated frame slots (triple buffer):
+//   the producer owns one, the consumer owns one, the
+//   third is handed over with one atomic exchange.
+//   No locks, no waiting and no heap after init
+// - Producer: claim() a slot, fill every pixel,
+//   publish(); it never touches the strips
+// - Consumer (output task): apply() takes the newest
+//   published frame and writes it into the strips
+//   (then refresh the strip / group as usual). A frame
+//   published over an unconsumed one replaces it: the
+//   older one is dropped, never shown late
+// - A frame covers all strips of the queue back to
+//   back, in order (a group: its members)
+// - Palette strips are not supported (RGB frames)
+// ==================================================
+
+typedef struct {
+    led_strip_t         *strips[LED_STRIP_GROUP_MAX];
+    size_t               count;
+    size_t               length;     // pixels per frame, all strips
+    rgb_t               *slots;      // 3 x length, one block
+
+    // Slot indices: back = producer's, front = consumer's,
+    // middle = the third one + "fresh" bit (shared)
+    uint8_t              back;
+    uint8_t              front;
+    atomic_uint          middle;
+
+    // Counters, each written by one side only
+    uint32_t             published;  // producer
+    uint32_t             dropped;    // producer: replaced before taken
+    uint32_t             taken;      // consumer
+} led_frame_queue_t;
+
+// strips must be initialized and outlive the queue
+esp_err_t led_frame_queue_init(
+    led_frame_queue_t *q,
+    led_strip_t *const *strips,
+    size_t count
+);
+void      led_frame_queue_free(led_frame_queue_t *q);
+
+// --------------------------------------------------
+// Producer side
+// --------------------------------------------------
+// length pixels to fill; the same slot until publish,
+// old contents are undefined
+rgb_t *led_frame_queue_claim(led_frame_queue_t *q);
+void   led_frame_queue_publish(led_frame_queue_t *q);
+
+// --------------------------------------------------
+// Consumer side
+// --------------------------------------------------
+// Newest frame published since the last take, or NULL;
+// valid until the next take
+const rgb_t *led_frame_queue_take(led_frame_queue_t *q);
+
+// take() + write it into the strips (RGB strips skip the
+// unchanged head / tail, so the refresh stays partial).
+// false = nothing new
+bool led_frame_queue_apply(led_frame_queue_t *q);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "led_strip.h"
+#include "led_strip_group.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 15 ? Fixed-rate frame scheduler
+//
+// - Library task calls render() once per frame and
+//   starts the transmit on the frame deadline, so
+//   render time does not show up as jitter
+// - Deadlines sit on a fixed microsecond grid (no
+//   drift); sleeps resolve to one FreeRTOS tick, so
+//   CONFIG_FREERTOS_HZ=1000 is best above ~30 fps
+// - Render for frame n+1 runs while frame n is on
+//   the wire (single-buffered strips wait for the
+//   wire first, so use buffer_count >= 2 for speed)
+// - A render that finishes after its deadline is
+//   late, handled by the policy below
+// - Host build: no task, call led_strip_sched_step()
+//   in a loop against the simulated clock
+// ==================================================
+
+typedef enum {
+    // Late frame goes out on the next grid slot,
+    // missed slots are dropped (frame index jumps)
+    LED_STRIP_SCHED_SKIP = 0,
+
+    // Late frame goes out at once and the grid
+    // restarts from there (missed slots merge into it)
+    LED_STRIP_SCHED_COALESCE,
+} led_strip_sched_policy_t;
+
+// frame = slot index the frame will be shown in,
+// time_us = its deadline (esp_timer clock)
+typedef void (*led_strip_render_cb_t)(uint32_t frame, int64_t time_us, void *ctx);
+
+typedef struct {
+    led_strip_t              *strip;        // exactly one of strip / group
+    led_strip_group_t        *group;
+    uint32_t                  fps;
+    led_strip_sched_policy_t  policy;
+    led_strip_render_cb_t     render;
+    void                     *ctx;
+
+    // Task settings (start only). A zeroed config
+    // runs on any core; set pin_core to use core_id
+    bool                      pin_core;     // false = any core
+    BaseType_t                core_id;      // only read when pin_core
+    UBaseType_t               priority;     // 0 = 5
+    uint32_t                  stack_size;   // 0 = 4096
+} led_strip_sched_config_t;
+
+typedef struct {
+    uint32_t frames;          // frames put on the wire
+    uint32_t late;            // renders that overran their deadline
+    uint32_t dropped;         // grid slots that got no new frame
+    uint32_t fps_milli;       // achieved FPS x 1000, last ~1 s window
+    uint32_t max_render_us;   // slowest render() so far
+} led_strip_sched_stats_t;
+
+typedef struct {
+    led_strip_sched_config_t  cfg;
+
+    int64_t                   period_us;
+    int64_t                   deadline_us;   // when the rendered frame goes out
+    uint32_t                  slot;          // frame index of the rendered frame
+    bool                      primed;
+
+    volatile bool             running;
+    TaskHandle_t              task;
+    SemaphoreHandle_t         stopped;
+
+    int64_t                   window_start_us;
+    uint32_t                  window_frames;
+    led_strip_sched_stats_t   stats;
+} led_strip_sched_t;
+
+esp_err_t led_strip_sched_init(
+    led_strip_sched_t *sched,
+    const led_strip_sched_config_t *config
+);
+
+// Run the scheduler task; ESP_ERR_NO_MEM if it cannot be
+// created (always on host: no tasks, use step())
+esp_err_t led_strip_sched_start(led_strip_sched_t *sched);
+
+// Stop the task after its current frame
+void led_strip_sched_stop(led_strip_sched_t *sched);
+
+// One frame: wait for the deadline, transmit, render
+// the next one. The task is a loop around this.
+esp_err_t led_strip_sched_step(led_strip_sched_t *sched);
+
+// Snapshot (counters are updated by the task)
+void led_strip_sched_get_stats(
+    const led_strip_sched_t *sched,
+    led_strip_sched_stats_t *out
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_attr.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Part 16 ? Per-strip performance counters
+//
+// - Opt-in: build with LED_STRIP_STATS=1 (CMake
+//   option of the same name); otherwise every hook
+//   compiles to nothing and led_strip_t has no
+//   stats fields
+// - CPU times (pixel writes, encode) come from the
+//   cycle counter, wire / wait times from esp_timer
+// - Pixel-write and encode times are per frame: all
+//   writes since the previous refresh, all encoder
+//   calls of one frame
+// ==================================================
+
+#ifndef LED_STRIP_STATS
+#define LED_STRIP_STATS 0
+#endif
+
+// Bin 0 = 0 us, bin i = [2^(i-1), 2^i) us,
+// last bin = everything from 2^(BINS-2) us up
+#define LED_STRIP_HIST_BINS 20
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t bins[LED_STRIP_HIST_BINS];
+} led_strip_hist_t;
+
+typedef struct {
+    uint32_t         frames;       // frames queued on the wire
+    uint64_t         bytes;        // wire bytes in those frames
+    uint32_t         skipped;      // refreshes with nothing to send
+    uint32_t         tx_errors;    // rmt_transmit failures
+    uint32_t         power_limited; // refreshes dimmed by the power budget
+    uint64_t         refills;      // RMT refill interrupts (encoder calls after the first fill)
+
+    led_strip_hist_t pixel_write;  // buffer writes per frame
+    led_strip_hist_t encode;       // encoder CPU per frame
+    led_strip_hist_t refill;       // encoder CPU inside refill interrupts per frame
+    led_strip_hist_t wire;         // frame start -> done (incl. latch)
+    led_strip_hist_t wait;         // blocked waiting for the wire
+} led_strip_stats_t;
+
+// Forward declaration only (core struct lives in led_strip.h)
+typedef struct led_strip_t led_strip_t;
+
+// Copy of the counters (ESP_ERR_NOT_SUPPORTED when
+// compiled out). Taken without locking, so a frame
+// finishing mid-copy may be half counted.
+esp_err_t led_strip_get_stats(const led_strip_t *strip, led_strip_stats_t *out);
+void      led_strip_reset_stats(led_strip_t *strip);
+
+// ==================================================
+// Hooks (library internal)
+// ==================================================
+#if LED_STRIP_STATS
+
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+static inline void IRAM_ATTR led_strip_hist_add(led_strip_hist_t *h, uint32_t us)
+{
+    uint32_t bin = us ? 32 - __builtin_clz(us) : 0;
+    if (bin >= LED_STRIP_HIST_BINS)
+        bin = LED_STRIP_HIST_BINS - 1;
+
+    h->bins[bin]++;
+    h->count++;
+    h->total_us += us;
+    if (us > h->max_us)
+        h->max_us = us;
+}
+
+static inline uint32_t IRAM_ATTR led_strip_cycles_to_us(uint32_t cycles)
+{
+    return cycles / esp_rom_get_cpu_ticks_per_us();
+}
+
+#define LED_STRIP_STATS_T0(t)               uint32_t t = esp_cpu_get_cycle_count()
+#define LED_STRIP_STATS_CYCLES(strip, f, t) ((strip)->f += esp_cpu_get_cycle_count() - (t))
+#define LED_STRIP_STATS_ADD(strip, f, n)    ((strip)->stats.f += (n))
+
+#else
+
+#define LED_STRIP_STATS_T0(t)               (void)0
+#define LED_STRIP_STATS_CYCLES(strip, f, t) (void)0
+#define LED_STRIP_STATS_ADD(strip, f, n)    (void)0
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
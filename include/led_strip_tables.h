@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "color.h"
+#include "led_strip_func.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================================================
+// Const color tables (flash)
+// - Generated by tools/gen_tables.py: the CMake build
+//   regenerates them, src/led_strip_tables.c is the
+//   default output for other build systems
+// - Read by the LUT rebuild only, never per pixel
+// ==================================================
+
+// [curve][v], v / 255 -> 0..255
+extern const uint8_t  led_gamma8[LED_GAMMA_COUNT][256];
+
+// [curve][i], i / 256 -> 0..65535 (interpolated by the
+// 16-bit encoder)
+extern const uint16_t led_gamma16[LED_GAMMA_COUNT][257];
+
+// Per-channel gains, 255 = unity
+extern const rgb_t    led_correction_gain[LED_CORRECTION_COUNT];
+
+// [(kelvin - MIN) / STEP], black body white point
+extern const rgb_t    led_temperature_gain[LED_TEMPERATURE_STEPS];
+
+#ifdef __cplusplus
+}
+#endif
@@ -13,4 +13,35 @@ const rgb_t COLOR_WHITE   = { 255, 255, 255 };
 const rgb_t COLOR_BLACK   = {   0,   0,   0 };
 const rgb_t COLOR_YELLOW  = { 255, 255,   0 };
 const rgb_t COLOR_CYAN    = {   0, 255, 255 };
-const rgb_t COLOR_MAGENTA = { 255,   0, 255 };
\ No newline at end of file
+const rgb_t COLOR_MAGENTA = { 255,   0, 255 };
+
+// --------------------------------------------------
+// RGBW span conversion (Part 8)
+// - Same math as the inline helpers, one call per span
+// --------------------------------------------------
+void rgb_to_rgbw_span(const rgb_t *src, rgbw_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        dst[i] = rgb_to_rgbw(src[i]);
+}
+
+void rgbw_to_rgb_span(const rgbw_t *src, rgb_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        dst[i] = rgbw_to_rgb(src[i]);
+}
+
+// --------------------------------------------------
+// HSV span conversion (Part 18)
+// --------------------------------------------------
+void hsv_to_rgb_span(const hsv_t *src, rgb_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        dst[i] = hsv_to_rgb(src[i]);
+}
+
+void rgb_to_hsv_span(const rgb_t *src, hsv_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        dst[i] = rgb_to_hsv(src[i]);
+}
@@ -4,79 +4,263 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "esp_attr.h"
 #include "esp_log.h"
-#include "esp_rom_sys.h"
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 
 #define TAG "led_strip_core"
 
 /* =================================================
-   WS2812 timing (nanoseconds)
+   Bit timing per LED type (nanoseconds)
    RMT resolution = 10 MHz -> 1 tick = 100 ns
 ==================================================*/
-#define T0H_NS   400
-#define T0L_NS   850
-#define T1H_NS   800
-#define T1L_NS   450
-#define RESET_US 60
+typedef struct {
+    uint16_t t0h_ns;
+    uint16_t t0l_ns;
+    uint16_t t1h_ns;
+    uint16_t t1l_ns;
+    uint16_t reset_us;
+} led_timing_t;
+
+static const led_timing_t k_timing[] = {
+    [LED_STRIP_WS2812] = { 400, 850, 800, 450, 60 },
+    [LED_STRIP_SK6812] = { 300, 900, 600, 600, 80 },
+};
 
 #define NS_TO_TICKS(ns) ((ns) / 100)
 
 #define CHECK(x)     do { esp_err_t r = (x); if (r != ESP_OK) return r; } while (0)
 #define CHECK_ARG(x) do { if (!(x)) return ESP_ERR_INVALID_ARG; } while (0)
 
+/* RMT defaults (led_strip_t.rmt fields left at 0) */
+#define MEM_BLOCK_SYMBOLS     64
+#define MEM_BLOCK_SYMBOLS_DMA 1024
+#define TRANS_QUEUE_DEPTH     4
+
+/* Buffer bytes holding the first `pixels` pixels
+   (4-bit palette: two per byte, rounded up) */
+static inline size_t frame_bytes_for(const led_strip_t *strip, size_t pixels)
+{
+    if (strip->palette_bits == 4)
+        return (pixels + 1) / 2;
+
+    return pixels * strip->bpp;
+}
+
 /* =================================================
-   Encode RAW GRB pixel
+   TX DONE (ISR)
+   Fires after the latch period (it is part of the
+   frame), so the LEDs already show the new frame.
+   - frame counter (per-strip completion)
+   - one more buffer free to render
+   - user completion callback
+   Shared by both backends (SPI: post_cb).
 ==================================================*/
-static inline void encode_grb(uint8_t *dst, rgb_t c)
+bool IRAM_ATTR led_strip_core_frame_done(led_strip_t *strip)
 {
-    dst[0] = c.g;
-    dst[1] = c.r;
-    dst[2] = c.b;
+    BaseType_t woken = pdFALSE;
+
+#if LED_STRIP_STATS
+    /* Queued frames start when the previous one ends */
+    int64_t now = esp_timer_get_time();
+    int64_t start = strip->submit_us[strip->tx_done % (2 * LED_STRIP_MAX_QUEUE)];
+    if (start < strip->last_done_us)
+        start = strip->last_done_us;
+    led_strip_hist_add(&strip->stats.wire, (uint32_t)(now - start));
+    strip->last_done_us = now;
+#endif
+
+    strip->tx_done++;
+
+    if (strip->frames_free)
+        xSemaphoreGiveFromISR(strip->frames_free, &woken);
+
+    /* Pairs with the release store in set_done_callback */
+    led_strip_done_cb_t cb = __atomic_load_n(&strip->on_done, __ATOMIC_ACQUIRE);
+    if (cb && cb(strip, strip->done_ctx))
+        woken = pdTRUE;
+
+    return woken == pdTRUE;
+}
+
+static bool IRAM_ATTR on_frame_done(
+    rmt_channel_handle_t channel,
+    const rmt_tx_done_event_data_t *edata,
+    void *user_ctx
+)
+{
+    (void)channel;
+    (void)edata;
+
+    return led_strip_core_frame_done(user_ctx);
 }
 
 /* =================================================
-   CORE INIT
+   RMT OUTPUT
+   Channel + bytes / latch / pixel encoders
 ==================================================*/
-esp_err_t led_strip_core_init(led_strip_t *strip)
+static esp_err_t rmt_output_init(led_strip_t *strip)
 {
-    CHECK_ARG(strip && strip->length > 0);
-
-    /* WS2812 = 3 bytes per pixel */
-    strip->buf = calloc(strip->length * 3, 1);
-    if (!strip->buf)
-        return ESP_ERR_NO_MEM;
+    const led_strip_rmt_config_t *rmt = &strip->rmt;
 
     rmt_tx_channel_config_t tx_cfg = {
         .gpio_num = strip->gpio,
         .clk_src = RMT_CLK_SRC_DEFAULT,
         .resolution_hz = 10 * 1000 * 1000,
-        .mem_block_symbols = 64,
-        .trans_queue_depth = 4,
+        .mem_block_symbols = rmt->mem_block_symbols,
+        .trans_queue_depth = rmt->trans_queue_depth,
+        .intr_priority = rmt->intr_priority,
+        .flags.with_dma = rmt->flags.with_dma,
     };
 
     CHECK(rmt_new_tx_channel(&tx_cfg, &strip->channel));
 
+    const led_timing_t *t = &k_timing[strip->type];
+
     rmt_bytes_encoder_config_t enc_cfg = {
         .bit0 = {
             .level0 = 1,
-            .duration0 = NS_TO_TICKS(T0H_NS),
+            .duration0 = NS_TO_TICKS(t->t0h_ns),
             .level1 = 0,
-            .duration1 = NS_TO_TICKS(T0L_NS),
+            .duration1 = NS_TO_TICKS(t->t0l_ns),
         },
         .bit1 = {
             .level0 = 1,
-            .duration0 = NS_TO_TICKS(T1H_NS),
+            .duration0 = NS_TO_TICKS(t->t1h_ns),
             .level1 = 0,
-            .duration1 = NS_TO_TICKS(T1L_NS),
+            .duration1 = NS_TO_TICKS(t->t1l_ns),
         },
         .flags.msb_first = true,
     };
 
     CHECK(rmt_new_bytes_encoder(&enc_cfg, &strip->bytes_encoder));
-    CHECK(rmt_enable(strip->channel));
+
+    /* Latch low period, appended to every frame */
+    rmt_copy_encoder_config_t copy_cfg = {0};
+    CHECK(rmt_new_copy_encoder(&copy_cfg, &strip->reset_encoder));
+
+    /* Color transform happens here, at encode time;
+       also picks the kernel for this pixel format */
+    CHECK(led_strip_core_new_encoder(
+        strip,
+        rmt->mem_block_symbols,
+        NS_TO_TICKS(t->reset_us * 1000u),
+        &strip->pixel_encoder
+    ));
+
+    rmt_tx_event_callbacks_t cbs = {
+        .on_trans_done = on_frame_done,
+    };
+    CHECK(rmt_tx_register_event_callbacks(strip->channel, &cbs, strip));
+
+    return rmt_enable(strip->channel);
+}
+
+/* Either backend; timeout_ms < 0 = forever */
+static esp_err_t output_wait(led_strip_t *strip, int timeout_ms)
+{
+    if (strip->backend == LED_STRIP_BACKEND_SPI)
+        return led_strip_spi_wait(strip, timeout_ms);
+
+    return rmt_tx_wait_all_done(strip->channel, timeout_ms);
+}
+
+/* =================================================
+   CORE INIT
+==================================================*/
+esp_err_t led_strip_core_init(led_strip_t *strip)
+{
+    CHECK_ARG(strip && strip->length > 0);
+    CHECK_ARG(strip->type <= LED_STRIP_SK6812);
+    CHECK_ARG(strip->backend <= LED_STRIP_BACKEND_SPI);
+
+    if (strip->buffer_count == 0)
+        strip->buffer_count = 1;
+    CHECK_ARG(strip->buffer_count <= LED_STRIP_MAX_BUFFERS);
+
+    /* RMT resources: 0 = default, the values in use are
+       written back; the driver checks what the target has */
+    led_strip_rmt_config_t *rmt = &strip->rmt;
+    if (rmt->mem_block_symbols == 0)
+        rmt->mem_block_symbols = rmt->flags.with_dma ? MEM_BLOCK_SYMBOLS_DMA : MEM_BLOCK_SYMBOLS;
+    if (rmt->trans_queue_depth == 0)
+        rmt->trans_queue_depth = TRANS_QUEUE_DEPTH;
+    CHECK_ARG(rmt->mem_block_symbols % 2 == 0);
+    CHECK_ARG(rmt->trans_queue_depth <= LED_STRIP_MAX_QUEUE);
+    CHECK_ARG(rmt->intr_priority >= 0 && rmt->intr_priority <= 3);
+
+    if (strip->type == LED_STRIP_SK6812)
+        strip->is_rgbw = true;
+
+    /* 16-bit dither has no white channel */
+    if (strip->is_rgbw && strip->linear16)
+        return ESP_ERR_NOT_SUPPORTED;
+
+    /* Palette entries are RGB, indices replace the color data */
+    CHECK_ARG(strip->palette_bits == 0 || strip->palette_bits == 4 || strip->palette_bits == 8);
+    if (strip->palette_bits && (strip->is_rgbw || strip->linear16))
+        return ESP_ERR_NOT_SUPPORTED;
+
+    /* 3 bytes per pixel (RGBW 4, 16-bit mode 6, palette
+       1 or half), one block for all frames */
+    strip->bpp = strip->palette_bits ? 1 : strip->linear16 ? 6 : strip->is_rgbw ? 4 : 3;
+    size_t frame_bytes = frame_bytes_for(strip, strip->length);
+
+    strip->frames[0] = calloc(frame_bytes * strip->buffer_count, 1);
+    if (!strip->frames[0])
+        return ESP_ERR_NO_MEM;
+
+    for (uint8_t i = 1; i < strip->buffer_count; i++)
+        strip->frames[i] = strip->frames[0] + i * frame_bytes;
+
+    strip->render_index = 0;
+    strip->buf = strip->frames[0];
+
+    if (strip->linear16) {
+        strip->dither_err = calloc(strip->length * 3, 1);
+        if (!strip->dither_err)
+            return ESP_ERR_NO_MEM;
+    }
+
+    /* Logical palette + its LUT-applied copy for the encoder */
+    if (strip->palette_bits) {
+        size_t entries = (size_t)1 << strip->palette_bits;
+        strip->palette = calloc(entries * 2, sizeof(rgb_t));
+        if (!strip->palette)
+            return ESP_ERR_NO_MEM;
+        strip->palette_lut = strip->palette + entries;
+    }
+
+    /* Every buffer except the one being rendered starts free */
+    if (strip->buffer_count > 1) {
+        strip->frames_free = xSemaphoreCreateCounting(
+            strip->buffer_count - 1,
+            strip->buffer_count - 1
+        );
+        if (!strip->frames_free)
+            return ESP_ERR_NO_MEM;
+    }
+
+    strip->tx_submitted = 0;
+    strip->tx_done = 0;
+
+#if LED_STRIP_STATS
+    memset(&strip->stats, 0, sizeof(strip->stats));
+    strip->write_cycles = 0;
+    strip->encode_cycles = 0;
+    strip->refill_cycles = 0;
+    strip->last_done_us = 0;
+#endif
+
+    if (strip->backend == LED_STRIP_BACKEND_SPI) {
+        led_strip_core_select_kernel(strip);
+        CHECK(led_strip_spi_init(strip, k_timing[strip->type].reset_us));
+    } else {
+        CHECK(rmt_output_init(strip));
+    }
 
     ESP_LOGI(TAG, "LED strip core initialized");
     return ESP_OK;
@@ -89,66 +273,237 @@ esp_err_t led_strip_core_free(led_strip_t *strip)
 {
     CHECK_ARG(strip);
 
+    led_strip_spi_free(strip);
+
     if (strip->channel) {
+        rmt_tx_wait_all_done(strip->channel, portMAX_DELAY);
         rmt_disable(strip->channel);
         rmt_del_channel(strip->channel);
         strip->channel = NULL;
     }
 
+    if (strip->pixel_encoder) {
+        rmt_del_encoder(strip->pixel_encoder);
+        strip->pixel_encoder = NULL;
+    }
+
     if (strip->bytes_encoder) {
         rmt_del_encoder(strip->bytes_encoder);
         strip->bytes_encoder = NULL;
     }
 
-    free(strip->buf);
+    if (strip->reset_encoder) {
+        rmt_del_encoder(strip->reset_encoder);
+        strip->reset_encoder = NULL;
+    }
+
+    if (strip->frames_free) {
+        vSemaphoreDelete(strip->frames_free);
+        strip->frames_free = NULL;
+    }
+
+    free(strip->frames[0]);
+    memset(strip->frames, 0, sizeof(strip->frames));
     strip->buf = NULL;
 
+    free(strip->dither_err);
+    strip->dither_err = NULL;
+
+    free(strip->palette);
+    strip->palette = NULL;
+    strip->palette_lut = NULL;
+
     return ESP_OK;
 }
 
 /* =================================================
-   CORE REFRESH (BLOCKING)
+   DIRTY TRACKING
+
+   WS2812 pixels keep their latched value when the
+   chain ends before them, so only the prefix up to
+   the last changed pixel has to go out again.
 ==================================================*/
-esp_err_t led_strip_core_refresh(led_strip_t *strip)
+void led_strip_core_mark_dirty(led_strip_t *strip, size_t start, size_t count)
+{
+    if (!strip || count == 0 || start >= strip->length)
+        return;
+
+    size_t end = start + count;
+    if (end > strip->length)
+        end = strip->length;
+
+    if (strip->dirty_end == 0 || start < strip->dirty_start)
+        strip->dirty_start = start;
+    if (end > strip->dirty_end)
+        strip->dirty_end = end;
+
+    /* Power sums follow pixel changes only (Part 20) */
+    if (strip->power_hi == 0 || start < strip->power_lo)
+        strip->power_lo = start;
+    if (end > strip->power_hi)
+        strip->power_hi = end;
+}
+
+/* =================================================
+   CORE SUBMIT
+
+   Queues the dirty prefix on the channel. force
+   sends at least pixel 0 even on a clean frame
+   (a sync group only starts once every member
+   has queued something).
+
+   Single buffer: buf goes on the wire, caller must
+   wait (is_busy) before touching pixels again.
+
+   Multi buffer: buf goes on the wire and buf moves
+   to the next frame in the ring, blocking only if
+   that frame is itself still being sent. The new
+   back buffer starts as a copy of the frame just
+   submitted so partial updates keep working.
+==================================================*/
+esp_err_t led_strip_core_submit(led_strip_t *strip, bool force)
 {
     CHECK_ARG(strip && strip->buf);
 
+    /* Dithered strips change every frame -> always whole strip */
+    if (strip->linear16)
+        led_strip_core_mark_dirty(strip, 0, strip->length);
+
+    size_t pixels = strip->dirty_end;
+    if (pixels == 0) {
+        if (!force) {
+            LED_STRIP_STATS_ADD(strip, skipped, 1);
+            return ESP_OK;
+        }
+        pixels = 1;
+    }
+
     rmt_transmit_config_t cfg = {
         .loop_count = 0
     };
 
-    CHECK(rmt_transmit(
-        strip->channel,
-        strip->bytes_encoder,
-        strip->buf,
-        strip->length * 3,
-        &cfg
-    ));
+#if LED_STRIP_STATS
+    strip->submit_us[strip->tx_submitted % (2 * LED_STRIP_MAX_QUEUE)] = esp_timer_get_time();
+#endif
+
+    /* Count first: the done ISR may fire before rmt_transmit returns */
+    strip->tx_submitted++;
+
+    esp_err_t err = strip->backend == LED_STRIP_BACKEND_SPI
+        ? led_strip_spi_transmit(strip, pixels)
+        : rmt_transmit(
+            strip->channel,
+            strip->pixel_encoder,
+            strip->buf,
+            frame_bytes_for(strip, pixels),
+            &cfg
+        );
+    if (err != ESP_OK) {
+        strip->tx_submitted--;
+        LED_STRIP_STATS_ADD(strip, tx_errors, 1);
+        return err;
+    }
+
+#if LED_STRIP_STATS
+    strip->stats.frames++;
+    strip->stats.bytes += pixels * (strip->is_rgbw ? 4 : 3);
+    led_strip_hist_add(&strip->stats.pixel_write, led_strip_cycles_to_us(strip->write_cycles));
+    strip->write_cycles = 0;
+#endif
+
+    strip->dirty_start = 0;
+    strip->dirty_end = 0;
+
+    if (strip->buffer_count <= 1)
+        return ESP_OK;
 
-    CHECK(rmt_tx_wait_all_done(strip->channel, portMAX_DELAY));
-    esp_rom_delay_us(RESET_US);
+#if LED_STRIP_STATS
+    int64_t t0 = esp_timer_get_time();
+    xSemaphoreTake(strip->frames_free, portMAX_DELAY);
+    led_strip_hist_add(&strip->stats.wait, (uint32_t)(esp_timer_get_time() - t0));
+#else
+    xSemaphoreTake(strip->frames_free, portMAX_DELAY);
+#endif
+
+    uint8_t *sent = strip->buf;
+
+    strip->render_index = (strip->render_index + 1) % strip->buffer_count;
+    strip->buf = strip->frames[strip->render_index];
+    memcpy(strip->buf, sent, frame_bytes_for(strip, strip->length));
 
     return ESP_OK;
 }
 
 /* =================================================
-   CORE REFRESH (ASYNC)
+   CORE ABORT
+   Only for frames that never started: no done ISR
+   ran for them, so nothing else touches the counters
 ==================================================*/
-esp_err_t led_strip_core_refresh_async(led_strip_t *strip)
+esp_err_t led_strip_core_abort(led_strip_t *strip)
+{
+    CHECK_ARG(strip && strip->buf && strip->channel);
+
+    CHECK(rmt_disable(strip->channel));
+
+    uint32_t dropped = strip->tx_submitted - strip->tx_done;
+    strip->tx_submitted = strip->tx_done;
+
+    /* Their buffers: no done ISR will hand them back */
+    if (strip->frames_free) {
+        for (uint32_t i = 0; i < dropped; i++)
+            xSemaphoreGive(strip->frames_free);
+    }
+
+    /* The dropped frames' pixels still have to go out */
+    led_strip_core_mark_dirty(strip, 0, strip->length);
+
+    return rmt_enable(strip->channel);
+}
+
+/* =================================================
+   CORE REFRESH (BLOCKING)
+   Sleeps on the driver until the frame and its
+   latch are out, no spinning
+==================================================*/
+esp_err_t led_strip_core_refresh(led_strip_t *strip)
 {
     CHECK_ARG(strip && strip->buf);
 
-    rmt_transmit_config_t cfg = {
-        .loop_count = 0
-    };
+    if (strip->dirty_end == 0 && !strip->linear16) {
+        LED_STRIP_STATS_ADD(strip, skipped, 1);
+        return ESP_OK;
+    }
+
+    CHECK(led_strip_core_submit(strip, false));
+    CHECK(led_strip_core_wait(strip, -1));
+
+    return ESP_OK;
+}
+
+/* =================================================
+   CORE WAIT
+==================================================*/
+esp_err_t led_strip_core_wait(led_strip_t *strip, int timeout_ms)
+{
+    CHECK_ARG(strip && (strip->channel || strip->spi));
+
+#if LED_STRIP_STATS
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = output_wait(strip, timeout_ms);
+    if (timeout_ms != 0)
+        led_strip_hist_add(&strip->stats.wait, (uint32_t)(esp_timer_get_time() - t0));
+    return err;
+#else
+    return output_wait(strip, timeout_ms);
+#endif
+}
 
-    return rmt_transmit(
-        strip->channel,
-        strip->bytes_encoder,
-        strip->buf,
-        strip->length * 3,
-        &cfg
-    );
+/* =================================================
+   CORE REFRESH (ASYNC)
+==================================================*/
+esp_err_t led_strip_core_refresh_async(led_strip_t *strip)
+{
+    return led_strip_core_submit(strip, false);
 }
 
 /* =================================================
@@ -156,14 +511,16 @@ esp_err_t led_strip_core_refresh_async(led_strip_t *strip)
 ==================================================*/
 bool led_strip_core_is_busy(led_strip_t *strip)
 {
-    if (!strip)
+    if (!strip || !(strip->channel || strip->spi))
         return false;
 
-    return rmt_tx_wait_all_done(strip->channel, 0) == ESP_ERR_TIMEOUT;
+    return output_wait(strip, 0) == ESP_ERR_TIMEOUT;
 }
 
 /* =================================================
    CORE PIXEL WRITE (RAW)
+   Logical value only ? LUT / order are applied
+   by the pixel encoder
 ==================================================*/
 esp_err_t led_strip_core_set_pixel(
     led_strip_t *strip,
@@ -172,6 +529,97 @@ esp_err_t led_strip_core_set_pixel(
 )
 {
     CHECK_ARG(strip && strip->buf && index < strip->length);
-    encode_grb(&strip->buf[index * 3], color);
+
+    /* Palette strips take indices only */
+    if (strip->palette_bits)
+        return ESP_ERR_NOT_SUPPORTED;
+
+    if (strip->linear16) {
+        rgb16_t *px16 = &((rgb16_t *)strip->buf)[index];
+        *px16 = (rgb16_t){ color.r * 257u, color.g * 257u, color.b * 257u };
+        led_strip_core_mark_dirty(strip, index, 1);
+        return ESP_OK;
+    }
+
+    if (strip->is_rgbw)
+        return led_strip_core_set_pixel_rgbw(
+            strip, index, (rgbw_t){ color.r, color.g, color.b, 0 });
+
+    uint8_t *px = &strip->buf[index * 3];
+
+    if (px[0] == color.r && px[1] == color.g && px[2] == color.b)
+        return ESP_OK;
+
+    px[0] = color.r;
+    px[1] = color.g;
+    px[2] = color.b;
+    led_strip_core_mark_dirty(strip, index, 1);
+
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/* =================================================
+   CORE PIXEL WRITE (RGBW strips only)
+==================================================*/
+esp_err_t led_strip_core_set_pixel_rgbw(
+    led_strip_t *strip,
+    size_t index,
+    rgbw_t color
+)
+{
+    CHECK_ARG(strip && strip->buf && strip->is_rgbw && index < strip->length);
+
+    _Static_assert(sizeof(rgbw_t) == 4, "rgbw_t must be 4 packed bytes");
+    rgbw_t *px = &((rgbw_t *)strip->buf)[index];
+
+    if (px->r == color.r && px->g == color.g && px->b == color.b && px->w == color.w)
+        return ESP_OK;
+
+    *px = color;
+    led_strip_core_mark_dirty(strip, index, 1);
+
+    return ESP_OK;
+}
+
+/* =================================================
+   RMT REFILL LOAD
+   Whole-strip frame: the first fill takes a full
+   block, every refill interrupt after that one half
+   (ping-pong), which has to land before the other
+   half is on the wire
+==================================================*/
+esp_err_t led_strip_core_rmt_load(const led_strip_t *strip, led_strip_rmt_load_t *out)
+{
+    CHECK_ARG(strip && out);
+
+    /* One DMA transaction per frame, no refills */
+    if (strip->backend != LED_STRIP_BACKEND_RMT)
+        return ESP_ERR_NOT_SUPPORTED;
+    CHECK_ARG(strip->channel);
+
+    const led_timing_t *t = &k_timing[strip->type];
+    /* Bit time as sent (ticks), not the nominal one */
+    uint64_t bit_ns = 100u * (NS_TO_TICKS(t->t0h_ns) + NS_TO_TICKS(t->t0l_ns));
+    size_t wire_bpp = strip->is_rgbw ? 4 : 3;
+
+    /* Data bits + one latch symbol */
+    uint64_t symbols = (uint64_t)strip->length * wire_bpp * 8 + 1;
+    uint64_t mem = strip->rmt.mem_block_symbols;
+    uint64_t half = mem / 2;
+
+    memset(out, 0, sizeof(*out));
+    out->frame_us = (uint32_t)((symbols - 1) * bit_ns / 1000 + t->reset_us);
+    out->refills = symbols > mem ? (uint32_t)((symbols - mem + half - 1) / half) : 0;
+    out->refill_period_us = (uint32_t)(half * bit_ns / 1000);
+
+#if LED_STRIP_STATS
+    const led_strip_hist_t *h = &strip->stats.refill;
+    if (h->count) {
+        out->measured = true;
+        out->isr_us = (uint32_t)(h->total_us / h->count);
+    }
+#endif
+
+    out->isr_load_permille = (uint32_t)((uint64_t)out->isr_us * 1000 / out->frame_us);
+    return ESP_OK;
+}
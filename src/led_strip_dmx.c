@@ -0,0 +1,296 @@
+#include "led_strip_dmx.h"
+#include "led_strip_func.h"
+
+#include <string.h>
+
+#include "esp_timer.h"
+
+// ==================================================
+// Wire formats (all fields big-endian unless noted)
+// ==================================================
+
+// E1.31 (ANSI E1.31-2016): root layer
+#define E131_ACN_ID         4       // "ASC-E1.17\0\0\0"
+#define E131_ROOT_VECTOR    18
+#define E131_FRAME_VECTOR   40
+
+#define E131_ROOT_DATA      0x00000004u
+#define E131_ROOT_EXTENDED  0x00000008u
+#define E131_FRAME_DATA     0x00000002u
+#define E131_FRAME_SYNC     0x00000001u
+
+// Data packet: framing + DMP layer
+#define E131_SYNC_ADDR      109
+#define E131_SEQ            111
+#define E131_OPTIONS        112
+#define E131_UNIVERSE       113
+#define E131_DMP_VECTOR     117
+#define E131_PROP_COUNT     123     // 1 + slots
+#define E131_START_CODE     125
+#define E131_DATA           126
+
+#define E131_OPT_PREVIEW    0x80
+#define E131_OPT_TERMINATED 0x40
+
+// Sync packet
+#define E131_SYNC_UNIVERSE  45
+#define E131_SYNC_LEN       49
+
+// Art-Net 4: OpCode / port address little-endian
+#define ARTNET_OPCODE       8
+#define ARTNET_UNIVERSE     14      // SubUni, Net
+#define ARTNET_LENGTH       16
+#define ARTNET_DATA         18
+
+#define ARTNET_OP_DMX       0x5000
+#define ARTNET_OP_SYNC      0x5200
+
+static const uint8_t k_e131_id[12]  = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+static const uint8_t k_artnet_id[8] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+
+static inline uint16_t be16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+static inline uint32_t be32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+// ==================================================
+// Lifecycle
+// ==================================================
+esp_err_t led_dmx_rx_init(
+    led_dmx_rx_t *rx,
+    const led_dmx_map_t *maps,
+    size_t count,
+    led_strip_group_t *group
+)
+{
+    if (!rx || !maps || count == 0 || count > LED_DMX_MAX_MAPS)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(rx, 0, sizeof(*rx));
+
+    for (size_t i = 0; i < count; i++) {
+        const led_dmx_map_t *m = &maps[i];
+
+        if (!m->strip || !m->strip->buf)
+            return ESP_ERR_INVALID_STATE;
+        if (m->slot >= LED_DMX_SLOTS || m->start >= m->strip->length)
+            return ESP_ERR_INVALID_ARG;
+
+        rx->maps[i] = *m;
+    }
+
+    rx->count = count;
+    rx->group = group;
+    return ESP_OK;
+}
+
+// ==================================================
+// Pixel writes
+// ==================================================
+static size_t slots_per_pixel(const led_strip_t *strip)
+{
+    if (strip->palette_bits)
+        return 1;
+    return strip->is_rgbw ? sizeof(rgbw_t) : sizeof(rgb_t);
+}
+
+// data = the universe's slots (no start code)
+static void write_map(const led_dmx_map_t *m, const uint8_t *data, size_t slots)
+{
+    led_strip_t *strip = m->strip;
+    size_t spp = slots_per_pixel(strip);
+
+    if (m->slot >= slots)
+        return;
+
+    size_t count = (slots - m->slot) / spp;
+    if (m->count && m->count < count)
+        count = m->count;
+
+    // Span writes clip to the strip
+    const uint8_t *src = data + m->slot;
+
+    if (strip->palette_bits)
+        led_strip_set_indices(strip, m->start, src, count);
+    else if (strip->is_rgbw)
+        led_strip_set_pixels_rgbw(strip, m->start, (const rgbw_t *)src, count);
+    else
+        led_strip_set_pixels_raw(strip, m->start, src, count);
+}
+
+// Bit i = maps[i] listens to universe
+static uint32_t universe_maps(const led_dmx_rx_t *rx, uint16_t universe)
+{
+    uint32_t mask = 0;
+
+    for (size_t i = 0; i < rx->count; i++)
+        if (rx->maps[i].universe == universe)
+            mask |= 1u << i;
+
+    return mask;
+}
+
+// E1.31 6.7.2: not newer = stale, unless far behind (sender
+// restarted). Maps on one universe share the sequence.
+static bool seq_stale(led_dmx_rx_t *rx, uint32_t mask, uint8_t seq)
+{
+    size_t i = (size_t)__builtin_ctz(mask);
+    int8_t d = (int8_t)(seq - rx->seq[i]);
+    bool stale = (rx->seq_valid & mask) && d <= 0 && d > -20;
+
+    if (!stale) {
+        for (size_t j = i; j < rx->count; j++)
+            if (mask & (1u << j))
+                rx->seq[j] = seq;
+        rx->seq_valid |= mask;
+    }
+
+    return stale;
+}
+
+static void write_universe(led_dmx_rx_t *rx, uint32_t mask, const uint8_t *data, size_t slots)
+{
+    _Static_assert(sizeof(rgbw_t) == 4, "rgbw_t must be 4 packed bytes");
+
+    for (size_t i = 0; i < rx->count; i++)
+        if (mask & (1u << i))
+            write_map(&rx->maps[i], data, slots);
+
+    rx->pending |= mask;
+    rx->packets++;
+}
+
+// ==================================================
+// Refresh
+// ==================================================
+void led_dmx_rx_refresh(led_dmx_rx_t *rx)
+{
+    if (!rx || !rx->pending)
+        return;
+
+    if (rx->group) {
+        led_strip_group_refresh_async(rx->group);
+    } else {
+        // Each strip once, however many maps it has
+        for (size_t i = 0; i < rx->count; i++) {
+            if (!(rx->pending & (1u << i)))
+                continue;
+
+            led_strip_t *strip = rx->maps[i].strip;
+            for (size_t j = i + 1; j < rx->count; j++)
+                if (rx->maps[j].strip == strip)
+                    rx->pending &= ~(1u << j);
+
+            led_strip_refresh_async(strip);
+        }
+    }
+
+    rx->pending = 0;
+}
+
+static led_dmx_result_t on_sync(led_dmx_rx_t *rx)
+{
+    rx->syncs++;
+    led_dmx_rx_refresh(rx);
+    return LED_DMX_SYNC;
+}
+
+// ==================================================
+// Parsers
+// ==================================================
+static led_dmx_result_t ingest_e131(led_dmx_rx_t *rx, const uint8_t *pkt, size_t len)
+{
+    uint32_t root = be32(pkt + E131_ROOT_VECTOR);
+    uint32_t frame = be32(pkt + E131_FRAME_VECTOR);
+
+    if (root == E131_ROOT_EXTENDED && frame == E131_FRAME_SYNC) {
+        if (len < E131_SYNC_LEN)
+            return LED_DMX_IGNORED;
+
+        uint16_t universe = be16(pkt + E131_SYNC_UNIVERSE);
+        if (rx->sync_universe && universe != rx->sync_universe)
+            return LED_DMX_IGNORED;
+
+        return on_sync(rx);
+    }
+
+    if (root != E131_ROOT_DATA || frame != E131_FRAME_DATA || len <= E131_DATA)
+        return LED_DMX_IGNORED;
+    if (pkt[E131_DMP_VECTOR] != 0x02 || pkt[E131_START_CODE] != 0x00)
+        return LED_DMX_IGNORED;
+
+    size_t slots = be16(pkt + E131_PROP_COUNT);
+    if (slots < 1)
+        return LED_DMX_IGNORED;
+    slots -= 1;
+    if (slots > LED_DMX_SLOTS || E131_DATA + slots > len)
+        return LED_DMX_IGNORED;
+
+    uint32_t mask = universe_maps(rx, be16(pkt + E131_UNIVERSE));
+    if (!mask)
+        return LED_DMX_IGNORED;
+
+    if ((pkt[E131_OPTIONS] & (E131_OPT_PREVIEW | E131_OPT_TERMINATED)) ||
+        seq_stale(rx, mask, pkt[E131_SEQ])) {
+        rx->dropped++;
+        return LED_DMX_IGNORED;
+    }
+
+    write_universe(rx, mask, pkt + E131_DATA, slots);
+    return be16(pkt + E131_SYNC_ADDR) ? LED_DMX_DATA_SYNCED : LED_DMX_DATA;
+}
+
+static led_dmx_result_t ingest_artnet(led_dmx_rx_t *rx, const uint8_t *pkt, size_t len)
+{
+    uint16_t op = (uint16_t)(pkt[ARTNET_OPCODE] | pkt[ARTNET_OPCODE + 1] << 8);
+
+    if (op == ARTNET_OP_SYNC) {
+        rx->artnet_sync = true;
+        rx->artnet_sync_us = esp_timer_get_time();
+        return on_sync(rx);
+    }
+
+    if (op != ARTNET_OP_DMX || len <= ARTNET_DATA)
+        return LED_DMX_IGNORED;
+
+    // 15-bit port address: Net (7 bits) : SubUni
+    uint16_t universe = (uint16_t)((pkt[ARTNET_UNIVERSE + 1] & 0x7f) << 8 | pkt[ARTNET_UNIVERSE]);
+    size_t slots = be16(pkt + ARTNET_LENGTH);
+
+    if (slots > LED_DMX_SLOTS || ARTNET_DATA + slots > len)
+        return LED_DMX_IGNORED;
+
+    uint32_t mask = universe_maps(rx, universe);
+    if (!mask)
+        return LED_DMX_IGNORED;
+
+    // Art-Net sequence is optional and unordered: not checked
+    write_universe(rx, mask, pkt + ARTNET_DATA, slots);
+
+    // A syncing sender sends one ArtSync per frame; once
+    // they stop, data is shown without one again
+    if (rx->artnet_sync &&
+        esp_timer_get_time() - rx->artnet_sync_us > (int64_t)LED_DMX_ARTNET_SYNC_MS * 1000)
+        rx->artnet_sync = false;
+
+    return rx->artnet_sync ? LED_DMX_DATA_SYNCED : LED_DMX_DATA;
+}
+
+led_dmx_result_t led_dmx_rx_ingest(led_dmx_rx_t *rx, const uint8_t *pkt, size_t len)
+{
+    if (!rx || !pkt)
+        return LED_DMX_IGNORED;
+
+    if (len >= E131_FRAME_VECTOR + 4 && !memcmp(pkt + E131_ACN_ID, k_e131_id, sizeof(k_e131_id)))
+        return ingest_e131(rx, pkt, len);
+
+    if (len >= ARTNET_OPCODE + 2 && !memcmp(pkt, k_artnet_id, sizeof(k_artnet_id)))
+        return ingest_artnet(rx, pkt, len);
+
+    return LED_DMX_IGNORED;
+}
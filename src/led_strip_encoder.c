@@ -0,0 +1,494 @@
+#include "led_strip_core.h"
+#include "led_strip.h"
+
+#include <stdlib.h>
+
+#include "esp_attr.h"
+
+/* =================================================
+   PIXEL ENCODER
+
+   - Reads the logical (R,G,B[,W], unscaled) frame buffer
+   - Applies the strip LUT (gamma x brightness x
+     balance) + wire order while staging pixels
+   - RGBW strips: 4 bytes in, 4 bytes out, W last
+   - 16-bit strips: fixed-point gain + temporal
+     error diffusion down to 8 bits instead of LUT
+   - Palette strips: 8 / 4-bit indices expanded
+     through the LUT-applied palette
+   - Kernel picked from the pixel format, order and
+     color settings when they change, never per call
+   - Hands each staged chunk to the WS2812 bytes
+     encoder, one RMT memory block worth at a time
+   - Ends every frame with the reset (latch) low
+     period as RMT symbols through the copy encoder,
+     so the done event fires once the LEDs latched
+
+   Runs from the RMT refill interrupt on hardware,
+   so everything on the encode path is IRAM.
+==================================================*/
+
+#define CHECK_ARG(x) do { if (!(x)) return ESP_ERR_INVALID_ARG; } while (0)
+
+typedef struct {
+    rmt_encoder_t         base;
+    rmt_encoder_handle_t  bytes;       /* borrowed from strip */
+    rmt_encoder_handle_t  latch;       /* copy encoder, borrowed from strip */
+    rmt_symbol_word_t     latch_code;  /* reset low period */
+    bool                  latching;    /* pixels done, sending latch_code */
+    led_strip_t          *strip;
+    size_t                chunk_px;    /* pixels staged per refill */
+    size_t                wire_bpp;    /* wire bytes per pixel */
+    size_t                next_px;     /* next pixel to stage */
+    size_t                staged;      /* bytes in stage[] */
+    bool                  stage_busy;  /* stage[] not fully encoded yet */
+    uint8_t               stage[];     /* chunk_px * wire_bpp */
+} pixel_encoder_t;
+
+/* =================================================
+   Stage kernels
+
+   One kernel per (order, pixel format, transform),
+   generated below with the wire offsets as
+   constants, so each pixel is a single fixed
+   shuffle with no order lookup or branch.
+
+   - lut  : LUT per channel (gamma x brightness x balance)
+   - raw  : LUT is identity (no gamma, full brightness,
+            unity balance) -> plain shuffle
+   - rgbw : 4 bytes in / out, W always last (SK6812 GRBW)
+   - 16   : 16-bit fixed-point gain + temporal dither,
+            with or without the 16-bit gamma curve
+   - pal  : 8 / 4-bit index -> palette_lut entry
+            (LUT already applied per entry)
+==================================================*/
+FORCE_INLINE_ATTR void stage8(
+    const led_strip_t *strip, const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint8_t *src = &frame[first * 3];
+    const uint8_t *lut_r = strip->lut[0];
+    const uint8_t *lut_g = strip->lut[1];
+    const uint8_t *lut_b = strip->lut[2];
+
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        dst[o_r] = lut_r[src[0]];
+        dst[o_g] = lut_g[src[1]];
+        dst[o_b] = lut_b[src[2]];
+    }
+}
+
+FORCE_INLINE_ATTR void stage8_raw(
+    const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint8_t *src = &frame[first * 3];
+
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        dst[o_r] = src[0];
+        dst[o_g] = src[1];
+        dst[o_b] = src[2];
+    }
+}
+
+FORCE_INLINE_ATTR void stage8_rgbw(
+    const led_strip_t *strip, const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint8_t *src = &frame[first * 4];
+    const uint8_t *lut_r = strip->lut[0];
+    const uint8_t *lut_g = strip->lut[1];
+    const uint8_t *lut_b = strip->lut[2];
+    const uint8_t *lut_w = strip->lut[3];
+
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        dst[o_r] = lut_r[src[0]];
+        dst[o_g] = lut_g[src[1]];
+        dst[o_b] = lut_b[src[2]];
+        dst[3]   = lut_w[src[3]];
+    }
+}
+
+FORCE_INLINE_ATTR void stage8_rgbw_raw(
+    const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint8_t *src = &frame[first * 4];
+
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        dst[o_r] = src[0];
+        dst[o_g] = src[1];
+        dst[o_b] = src[2];
+        dst[3]   = src[3];
+    }
+}
+
+FORCE_INLINE_ATTR void stage_pal8(
+    const led_strip_t *strip, const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint8_t *src = &frame[first];
+    const rgb_t *pal = strip->palette_lut;
+
+    for (size_t i = 0; i < count; i++, dst += 3) {
+        rgb_t c = pal[src[i]];
+        dst[o_r] = c.r;
+        dst[o_g] = c.g;
+        dst[o_b] = c.b;
+    }
+}
+
+/* Even pixel in the low nibble */
+FORCE_INLINE_ATTR void stage_pal4(
+    const led_strip_t *strip, const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const rgb_t *pal = strip->palette_lut;
+
+    for (size_t px = first; px < first + count; px++, dst += 3) {
+        rgb_t c = pal[(frame[px >> 1] >> ((px & 1) * 4)) & 0x0f];
+        dst[o_r] = c.r;
+        dst[o_g] = c.g;
+        dst[o_b] = c.b;
+    }
+}
+
+/* -------------------------------------------------
+   16-bit linear -> wire bytes
+
+   t   = (v * gain) >> 16 + residual    (gain <= 65280)
+   out = t >> 8, residual = t & 0xff
+
+   gain tops out at 255 * 256 so t never passes
+   0xffff and out never needs clamping. The residual
+   carries to the same channel next frame, so the
+   time-average hits the 16-bit value.
+--------------------------------------------------*/
+FORCE_INLINE_ATTR uint32_t gamma16_apply(const uint16_t *curve, uint32_t v)
+{
+    uint32_t i = v >> 8;
+    uint32_t f = v & 0xff;
+    return curve[i] + (((uint32_t)(curve[i + 1] - curve[i]) * f) >> 8);
+}
+
+FORCE_INLINE_ATTR uint8_t dither8(uint32_t v, uint32_t gain, uint8_t *err)
+{
+    uint32_t t = ((v * gain) >> 16) + *err;
+    *err = (uint8_t)t;
+    return (uint8_t)(t >> 8);
+}
+
+FORCE_INLINE_ATTR void stage16(
+    const led_strip_t *strip, const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint16_t *src = (const uint16_t *)frame + first * 3;
+    uint8_t *err = &strip->dither_err[first * 3];
+    const uint32_t g_r = strip->gain_q16[0];
+    const uint32_t g_g = strip->gain_q16[1];
+    const uint32_t g_b = strip->gain_q16[2];
+
+    for (size_t i = 0; i < count; i++, src += 3, err += 3, dst += 3) {
+        dst[o_r] = dither8(src[0], g_r, &err[0]);
+        dst[o_g] = dither8(src[1], g_g, &err[1]);
+        dst[o_b] = dither8(src[2], g_b, &err[2]);
+    }
+}
+
+FORCE_INLINE_ATTR void stage16_gamma(
+    const led_strip_t *strip, const uint8_t *frame, size_t first, size_t count,
+    uint8_t *dst, const int o_r, const int o_g, const int o_b
+)
+{
+    const uint16_t *src = (const uint16_t *)frame + first * 3;
+    uint8_t *err = &strip->dither_err[first * 3];
+    const uint32_t g_r = strip->gain_q16[0];
+    const uint32_t g_g = strip->gain_q16[1];
+    const uint32_t g_b = strip->gain_q16[2];
+    const uint16_t *curve = strip->gamma16;
+
+    for (size_t i = 0; i < count; i++, src += 3, err += 3, dst += 3) {
+        dst[o_r] = dither8(gamma16_apply(curve, src[0]), g_r, &err[0]);
+        dst[o_g] = dither8(gamma16_apply(curve, src[1]), g_g, &err[1]);
+        dst[o_b] = dither8(gamma16_apply(curve, src[2]), g_b, &err[2]);
+    }
+}
+
+/* -------------------------------------------------
+   Instantiation
+
+   LED_ORDERS lists every order with the wire
+   position of logical r, g, b.
+--------------------------------------------------*/
+#define LED_ORDERS(X)        \
+    X(GRB, 1, 0, 2)          \
+    X(RGB, 0, 1, 2)          \
+    X(BRG, 1, 2, 0)          \
+    X(RBG, 0, 2, 1)          \
+    X(GBR, 2, 0, 1)          \
+    X(BGR, 2, 1, 0)
+
+typedef enum {
+    KERNEL_LUT = 0,
+    KERNEL_RAW,
+    KERNEL_RGBW_LUT,
+    KERNEL_RGBW_RAW,
+    KERNEL_16,
+    KERNEL_16_GAMMA,
+    KERNEL_PAL8,
+    KERNEL_PAL4,
+    KERNEL_COUNT
+} kernel_kind_t;
+
+#define STAGE_ARGS                                                          \
+    const led_strip_t *strip, const uint8_t *frame, size_t first,           \
+    size_t count, uint8_t *dst
+
+#define DEFINE_KERNELS(ORD, R, G, B)                                        \
+    static void IRAM_ATTR stage_lut_##ORD(STAGE_ARGS)                       \
+    { stage8(strip, frame, first, count, dst, R, G, B); }                   \
+    static void IRAM_ATTR stage_raw_##ORD(STAGE_ARGS)                       \
+    { (void)strip; stage8_raw(frame, first, count, dst, R, G, B); }         \
+    static void IRAM_ATTR stage_rgbw_lut_##ORD(STAGE_ARGS)                  \
+    { stage8_rgbw(strip, frame, first, count, dst, R, G, B); }              \
+    static void IRAM_ATTR stage_rgbw_raw_##ORD(STAGE_ARGS)                  \
+    { (void)strip; stage8_rgbw_raw(frame, first, count, dst, R, G, B); }    \
+    static void IRAM_ATTR stage_16_##ORD(STAGE_ARGS)                        \
+    { stage16(strip, frame, first, count, dst, R, G, B); }                  \
+    static void IRAM_ATTR stage_16_gamma_##ORD(STAGE_ARGS)                  \
+    { stage16_gamma(strip, frame, first, count, dst, R, G, B); }            \
+    static void IRAM_ATTR stage_pal8_##ORD(STAGE_ARGS)                      \
+    { stage_pal8(strip, frame, first, count, dst, R, G, B); }               \
+    static void IRAM_ATTR stage_pal4_##ORD(STAGE_ARGS)                      \
+    { stage_pal4(strip, frame, first, count, dst, R, G, B); }
+
+#define KERNEL_ROW(ORD, R, G, B)                                            \
+    [LED_ORDER_##ORD] = {                                                   \
+        [KERNEL_LUT]      = stage_lut_##ORD,                                \
+        [KERNEL_RAW]      = stage_raw_##ORD,                                \
+        [KERNEL_RGBW_LUT] = stage_rgbw_lut_##ORD,                           \
+        [KERNEL_RGBW_RAW] = stage_rgbw_raw_##ORD,                           \
+        [KERNEL_16]       = stage_16_##ORD,                                 \
+        [KERNEL_16_GAMMA] = stage_16_gamma_##ORD,                           \
+        [KERNEL_PAL8]     = stage_pal8_##ORD,                               \
+        [KERNEL_PAL4]     = stage_pal4_##ORD,                               \
+    },
+
+LED_ORDERS(DEFINE_KERNELS)
+
+static const DRAM_ATTR led_strip_stage_fn_t k_kernels[][KERNEL_COUNT] = {
+    LED_ORDERS(KERNEL_ROW)
+};
+
+/* =================================================
+   Kernel selection
+   Called at init and whenever the color settings
+   change, never from the encode path
+==================================================*/
+void led_strip_core_select_kernel(led_strip_t *strip)
+{
+    /* LUT is identity -> skip the lookups */
+    bool identity = !strip->gamma_enabled &&
+                    strip->brightness == 255 &&
+                    strip->power_scale == 255 &&
+                    strip->color_gain.r == 255 &&
+                    strip->color_gain.g == 255 &&
+                    strip->color_gain.b == 255;
+
+    kernel_kind_t kind;
+
+    if (strip->palette_bits)
+        kind = strip->palette_bits == 4 ? KERNEL_PAL4 : KERNEL_PAL8;
+    else if (strip->linear16)
+        kind = strip->gamma16 ? KERNEL_16_GAMMA : KERNEL_16;
+    else if (strip->is_rgbw)
+        kind = identity ? KERNEL_RGBW_RAW : KERNEL_RGBW_LUT;
+    else
+        kind = identity ? KERNEL_RAW : KERNEL_LUT;
+
+    strip->stage = k_kernels[strip->order][kind];
+}
+
+/* =================================================
+   Stage: pixels [first, first + count) of frame
+   into count * wire bytes, through the kernel the
+   strip picked at init
+==================================================*/
+void IRAM_ATTR led_strip_core_stage_pixels(
+    const led_strip_t *strip,
+    const uint8_t *frame,
+    size_t first,
+    size_t count,
+    uint8_t *dst
+)
+{
+    strip->stage(strip, frame, first, count, dst);
+}
+
+/* =================================================
+   rmt_encoder_t interface
+==================================================*/
+static size_t IRAM_ATTR pixel_encode(
+    rmt_encoder_t *encoder,
+    rmt_channel_handle_t channel,
+    const void *primary_data,
+    size_t data_size,
+    rmt_encode_state_t *ret_state
+)
+{
+    LED_STRIP_STATS_T0(t0);
+
+    pixel_encoder_t *enc = (pixel_encoder_t *)encoder;
+
+#if LED_STRIP_STATS
+    /* Every call after the first fill is a refill interrupt */
+    bool refill = enc->next_px != 0 || enc->stage_busy || enc->latching;
+#endif
+
+    const uint8_t *frame = primary_data;
+    size_t total_px = data_size / enc->strip->bpp;
+
+    /* 4-bit palette: the last byte may hold one pixel */
+    if (enc->strip->palette_bits == 4) {
+        total_px = data_size * 2;
+        if (total_px > enc->strip->length)
+            total_px = enc->strip->length;
+    }
+    size_t written = 0;
+    rmt_encode_state_t state = RMT_ENCODING_RESET;
+
+    for (;;) {
+        if (enc->latching) {
+            rmt_encode_state_t sub = RMT_ENCODING_RESET;
+            written += enc->latch->encode(
+                enc->latch, channel, &enc->latch_code, sizeof(enc->latch_code), &sub);
+
+            if (sub & RMT_ENCODING_COMPLETE) {
+                enc->latching = false;
+                enc->next_px = 0;
+                state |= RMT_ENCODING_COMPLETE;
+            }
+            if (sub & RMT_ENCODING_MEM_FULL)
+                state |= RMT_ENCODING_MEM_FULL;
+            break;
+        }
+
+        if (!enc->stage_busy) {
+            if (enc->next_px >= total_px) {
+                enc->latching = true;
+                continue;
+            }
+
+            size_t n = total_px - enc->next_px;
+            if (n > enc->chunk_px)
+                n = enc->chunk_px;
+
+            enc->strip->stage(enc->strip, frame, enc->next_px, n, enc->stage);
+            enc->staged = n * enc->wire_bpp;
+            enc->next_px += n;
+            enc->stage_busy = true;
+        }
+
+        rmt_encode_state_t sub = RMT_ENCODING_RESET;
+        written += enc->bytes->encode(enc->bytes, channel, enc->stage, enc->staged, &sub);
+
+        if (sub & RMT_ENCODING_COMPLETE)
+            enc->stage_busy = false;
+
+        if (sub & RMT_ENCODING_MEM_FULL) {
+            state |= RMT_ENCODING_MEM_FULL;
+            break;
+        }
+    }
+
+#if LED_STRIP_STATS
+    LED_STRIP_STATS_CYCLES(enc->strip, encode_cycles, t0);
+    if (refill) {
+        LED_STRIP_STATS_CYCLES(enc->strip, refill_cycles, t0);
+        LED_STRIP_STATS_ADD(enc->strip, refills, 1);
+    }
+    if (state & RMT_ENCODING_COMPLETE) {
+        led_strip_hist_add(&enc->strip->stats.encode,
+                           led_strip_cycles_to_us(enc->strip->encode_cycles));
+        led_strip_hist_add(&enc->strip->stats.refill,
+                           led_strip_cycles_to_us(enc->strip->refill_cycles));
+        enc->strip->encode_cycles = 0;
+        enc->strip->refill_cycles = 0;
+    }
+#endif
+
+    *ret_state = state;
+    return written;
+}
+
+static esp_err_t pixel_reset(rmt_encoder_t *encoder)
+{
+    pixel_encoder_t *enc = (pixel_encoder_t *)encoder;
+
+    enc->next_px = 0;
+    enc->staged = 0;
+    enc->stage_busy = false;
+    enc->latching = false;
+    rmt_encoder_reset(enc->latch);
+    return rmt_encoder_reset(enc->bytes);
+}
+
+static esp_err_t pixel_del(rmt_encoder_t *encoder)
+{
+    free(encoder);
+    return ESP_OK;
+}
+
+/* =================================================
+   CREATE
+==================================================*/
+esp_err_t led_strip_core_new_encoder(
+    led_strip_t *strip,
+    size_t mem_block_symbols,
+    uint32_t reset_ticks,
+    rmt_encoder_handle_t *ret_encoder
+)
+{
+    CHECK_ARG(strip && strip->bytes_encoder && strip->reset_encoder && ret_encoder);
+    /* One symbol holds two 15-bit durations */
+    CHECK_ARG(reset_ticks > 0 && reset_ticks <= 2 * 0x7fff);
+
+    size_t wire_bpp = strip->is_rgbw ? 4 : 3;
+
+    led_strip_core_select_kernel(strip);
+
+    /* Stage up to one block of symbols (8 per byte); the
+       driver refills half blocks, so a chunk spans two */
+    size_t chunk_px = mem_block_symbols / (8 * wire_bpp);
+    if (chunk_px == 0)
+        chunk_px = 1;
+
+    pixel_encoder_t *enc = calloc(1, sizeof(*enc) + chunk_px * wire_bpp);
+    if (!enc)
+        return ESP_ERR_NO_MEM;
+
+    enc->base.encode = pixel_encode;
+    enc->base.reset = pixel_reset;
+    enc->base.del = pixel_del;
+    enc->bytes = strip->bytes_encoder;
+    enc->latch = strip->reset_encoder;
+    enc->latch_code = (rmt_symbol_word_t){
+        .level0 = 0,
+        .duration0 = reset_ticks / 2,
+        .level1 = 0,
+        .duration1 = reset_ticks - reset_ticks / 2,
+    };
+    enc->strip = strip;
+    enc->chunk_px = chunk_px;
+    enc->wire_bpp = wire_bpp;
+
+    *ret_encoder = &enc->base;
+    return ESP_OK;
+}
@@ -3,73 +3,127 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "led_strip_tables.h"
 
 // ==================================================
-// Internal state (global helper state)
+// Internal state
+// - None: the gamma curves and color gains are const
+//   tables (led_strip_tables.h); brightness / gamma /
+//   white balance live on each strip
 // ==================================================
-static uint8_t g_brightness = 255; // full brightness
-static bool    g_gamma_enabled = false;
-static bool    g_gamma_ready   = false;
-static uint8_t g_gamma_lut[256];
 
 // ==================================================
-// Gamma LUT (Part 6)
+// Helpers (existing + extended)
 // ==================================================
-static void gamma_init(void)
+
+// Exact c * level / 255 without a divide
+static inline uint8_t scale_255(uint8_t c, uint8_t level)
 {
-    if (g_gamma_ready)
-        return;
+    uint32_t x = (uint32_t)c * level;
+    return (uint8_t)((x + 1 + (x >> 8)) >> 8);
+}
 
-    for (int i = 0; i < 256; i++) {
-        float x = (float)i / 255.0f;
-        g_gamma_lut[i] = (uint8_t)(powf(x, 2.2f) * 255.0f + 0.5f);
+// ==================================================
+// Part 11 ? Per-strip fused color LUT
+// lut[ch][v] = color_gain[ch] * brightness * gamma(v)
+// (color_gain = balance x correction x temperature)
+// Rebuilt only when one of the three changes; the
+// pixel encoder applies it, so the buffer keeps its
+// logical values and only needs resending
+// (Part 20: brightness includes the power scale)
+// ==================================================
+static void palette_apply(led_strip_t *strip, size_t first, size_t count)
+{
+    for (size_t i = first; i < first + count; i++) {
+        rgb_t c = strip->palette[i];
+        strip->palette_lut[i] = (rgb_t){
+            strip->lut[0][c.r],
+            strip->lut[1][c.g],
+            strip->lut[2][c.b],
+        };
     }
+}
 
-    g_gamma_ready = true;
+// Selected curve, NULL = gamma off
+static const uint8_t *gamma_curve(const led_strip_t *strip)
+{
+    return strip->gamma_enabled ? led_gamma8[strip->gamma_curve] : NULL;
 }
 
-static inline rgb_t apply_gamma(rgb_t c)
+// Nearest table step, clamped; 0 stays off
+static uint16_t temperature_step(uint16_t kelvin)
 {
-    if (!g_gamma_enabled)
-        return c;
+    if (!kelvin)
+        return 0;
+    if (kelvin < LED_TEMPERATURE_MIN)
+        kelvin = LED_TEMPERATURE_MIN;
+    if (kelvin > LED_TEMPERATURE_MAX)
+        kelvin = LED_TEMPERATURE_MAX;
+
+    return (uint16_t)((kelvin + LED_TEMPERATURE_STEP / 2) / LED_TEMPERATURE_STEP * LED_TEMPERATURE_STEP);
+}
+
+// balance x correction x temperature
+static rgb_t color_gain(const led_strip_t *strip)
+{
+    rgb_t g = strip->white_balance;
+    rgb_t c = led_correction_gain[strip->correction];
 
-    gamma_init();
-    c.r = g_gamma_lut[c.r];
-    c.g = g_gamma_lut[c.g];
-    c.b = g_gamma_lut[c.b];
-    return c;
+    g = (rgb_t){ scale_255(g.r, c.r), scale_255(g.g, c.g), scale_255(g.b, c.b) };
+
+    if (strip->temperature_k) {
+        rgb_t t = led_temperature_gain[(strip->temperature_k - LED_TEMPERATURE_MIN) / LED_TEMPERATURE_STEP];
+        g = (rgb_t){ scale_255(g.r, t.r), scale_255(g.g, t.g), scale_255(g.b, t.b) };
+    }
+
+    return g;
 }
 
-// ==================================================
-// Helpers (existing + extended)
-// ==================================================
-static inline rgb_t scale_and_reorder(
-    led_strip_t *strip,
-    rgb_t c
-)
+static void lut_rebuild(led_strip_t *strip)
 {
-    // ---- gamma ----
-    c = apply_gamma(c);
+    strip->color_gain = color_gain(strip);
+
+    const uint8_t gain[3] = {
+        strip->color_gain.r,
+        strip->color_gain.g,
+        strip->color_gain.b,
+    };
+    const uint8_t level = scale_255(strip->brightness, strip->power_scale);
+    const uint8_t *curve = gamma_curve(strip);
+
+    for (int v = 0; v < 256; v++) {
+        uint8_t g = curve ? curve[v] : (uint8_t)v;
+        uint8_t b = scale_255(g, level);
 
-    // ---- brightness ----
-    if (g_brightness != 255) {
-        c.r = (uint16_t)c.r * g_brightness / 255;
-        c.g = (uint16_t)c.g * g_brightness / 255;
-        c.b = (uint16_t)c.b * g_brightness / 255;
+        for (int ch = 0; ch < 3; ch++)
+            strip->lut[ch][v] = scale_255(b, gain[ch]);
+
+        // White die has no balance gain
+        strip->lut[3][v] = b;
     }
 
-    // ---- color order ----
-    switch (strip->order) {
-        case LED_ORDER_RGB:
-            return (rgb_t){ c.r, c.g, c.b };
+    // 16-bit path: same settings as a Q16 gain, topped
+    // at 255 * 256 so the dither never overflows 8 bits
+    for (int ch = 0; ch < 3; ch++)
+        strip->gain_q16[ch] = (uint32_t)level * gain[ch] * 65280u / 65025u;
+
+    strip->gamma16 = strip->gamma_enabled ? led_gamma16[strip->gamma_curve] : NULL;
 
-        case LED_ORDER_BRG:
-            return (rgb_t){ c.b, c.r, c.g };
+    // Palette strips: the encoder reads entries through the LUT
+    if (strip->palette_lut)
+        palette_apply(strip, 0, (size_t)1 << strip->palette_bits);
 
-        case LED_ORDER_GRB:
-        default:
-            return (rgb_t){ c.g, c.r, c.b };
+    // Identity LUT / gamma on-off pick a different kernel
+    led_strip_core_select_kernel(strip);
+
+    // Resend everything; pixels are unchanged, so the
+    // power sums stay valid (no mark_dirty)
+    if (strip->length) {
+        strip->dirty_start = 0;
+        strip->dirty_end = strip->length;
     }
 }
 
@@ -81,10 +135,35 @@ void led_strip_init(led_strip_t *strip)
     if (!strip)
         return;
 
-    if (strip->order > LED_ORDER_BRG)
+    if (strip->order > LED_ORDER_BGR)
         strip->order = LED_ORDER_GRB;
 
-    led_strip_core_init(strip);
+    // Zero-initialised descriptor -> full brightness, no tint
+    if (strip->brightness == 0)
+        strip->brightness = 255;
+
+    if (!strip->white_balance.r && !strip->white_balance.g && !strip->white_balance.b)
+        strip->white_balance = (rgb_t){ 255, 255, 255 };
+
+    // Table selections set before init, out of range = default
+    if (strip->gamma_curve >= LED_GAMMA_COUNT)
+        strip->gamma_curve = LED_GAMMA_2_2;
+    if (strip->correction >= LED_CORRECTION_COUNT)
+        strip->correction = LED_CORRECTION_NONE;
+    strip->temperature_k = temperature_step(strip->temperature_k);
+
+    if (!strip->power_channel_ma && !strip->power_idle_ua) {
+        strip->power_channel_ma = 20;
+        strip->power_idle_ua = 1000;
+    }
+    strip->power_scale = 255;
+
+    lut_rebuild(strip);
+
+    // Failed init (e.g. no RMT memory left for the
+    // requested block) releases everything: buf == NULL
+    if (led_strip_core_init(strip) != ESP_OK)
+        led_strip_core_free(strip);
 }
 
 void led_strip_free(led_strip_t *strip)
@@ -92,8 +171,12 @@ void led_strip_free(led_strip_t *strip)
     if (!strip)
         return;
 
-    led_strip_clear(strip);
+    // No final transmit: clear + refresh first if the LEDs
+    // should go dark
     led_strip_core_free(strip);
+
+    free(strip->power_blocks);
+    strip->power_blocks = NULL;
 }
 
 // ==================================================
@@ -104,6 +187,9 @@ void led_strip_refresh(led_strip_t *strip)
     if (!strip)
         return;
 
+    if (strip->power_budget_ma)
+        led_strip_power_limit(&strip, 1, 0);
+
     led_strip_core_refresh(strip);
 }
 
@@ -112,6 +198,12 @@ void led_strip_clear(led_strip_t *strip)
     if (!strip)
         return;
 
+    // Palette strips: every pixel to index 0
+    if (strip->palette_bits) {
+        led_strip_fill_index(strip, 0, strip->length, 0);
+        return;
+    }
+
     rgb_t black = { 0, 0, 0 };
     led_strip_fill(strip, black);
 }
@@ -124,17 +216,39 @@ void led_strip_refresh_async(led_strip_t *strip)
     if (!strip)
         return;
 
-    rmt_transmit_config_t cfg = {
-        .loop_count = 0
-    };
+    if (strip->power_budget_ma)
+        led_strip_power_limit(&strip, 1, 0);
 
-    rmt_transmit(
-        strip->channel,
-        strip->composite_encoder,
-        strip->buf,
-        strip->length * 3,
-        &cfg
-    );
+    led_strip_core_refresh_async(strip);
+}
+
+esp_err_t led_strip_set_done_callback(
+    led_strip_t *strip,
+    led_strip_done_cb_t cb,
+    void *ctx
+)
+{
+    if (!strip)
+        return ESP_ERR_INVALID_ARG;
+
+    // No frame in flight = no done ISR to race with
+    if (strip->tx_submitted != strip->tx_done)
+        return ESP_ERR_INVALID_STATE;
+
+    // ctx first, cb published last: the ISR loads on_done
+    // (acquire) before it reads done_ctx
+    __atomic_store_n(&strip->on_done, NULL, __ATOMIC_RELEASE);
+    strip->done_ctx = ctx;
+    __atomic_store_n(&strip->on_done, cb, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+void led_strip_invalidate(led_strip_t *strip)
+{
+    if (!strip)
+        return;
+
+    led_strip_core_mark_dirty(strip, 0, strip->length);
 }
 
 bool led_strip_is_busy(led_strip_t *strip)
@@ -142,7 +256,7 @@ bool led_strip_is_busy(led_strip_t *strip)
     if (!strip)
         return false;
 
-    return rmt_tx_wait_all_done(strip->channel, 0) == ESP_ERR_TIMEOUT;
+    return led_strip_core_is_busy(strip);
 }
 
 // ==================================================
@@ -157,8 +271,9 @@ void led_strip_set_pixel(
     if (!strip || index >= strip->length)
         return;
 
-    rgb_t mapped = scale_and_reorder(strip, color);
-    led_strip_core_set_pixel(strip, index, mapped);
+    LED_STRIP_STATS_T0(t0);
+    led_strip_core_set_pixel(strip, index, color);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
 }
 
 void led_strip_fill(
@@ -169,16 +284,188 @@ void led_strip_fill(
     if (!strip)
         return;
 
-    rgb_t mapped = scale_and_reorder(strip, color);
+    led_strip_fill_range(strip, 0, strip->length, color);
+}
 
-    for (size_t i = 0; i < strip->length; i++)
-        led_strip_core_set_pixel(strip, i, mapped);
+// ==================================================
+// Part 10 ? Bulk span writes
+// ==================================================
 
-    led_strip_core_refresh(strip);
+// Buffer holds logical R,G,B ? a span is a straight copy
+// (RGBW strips: W = 0, 16-bit strips: v * 257)
+static void write_span(
+    led_strip_t *strip,
+    size_t start,
+    const uint8_t *src,
+    size_t count
+)
+{
+    if (!strip || !strip->buf || !src || start >= strip->length || strip->palette_bits)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->linear16) {
+        uint16_t *dst = (uint16_t *)strip->buf + start * 3;
+        for (size_t i = 0; i < count * 3; i++)
+            dst[i] = src[i] * 257u;
+    } else if (strip->is_rgbw) {
+        uint8_t *dst = &strip->buf[start * 4];
+        for (size_t i = 0; i < count; i++, src += 3, dst += 4) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = 0;
+        }
+    } else {
+        memcpy(&strip->buf[start * 3], src, count * 3);
+    }
+
+    led_strip_core_mark_dirty(strip, start, count);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+// Fill: memset when every byte of the pixel matches, else
+// write one pixel and keep doubling the filled prefix with memcpy
+void led_strip_fill_range(
+    led_strip_t *strip,
+    size_t start,
+    size_t count,
+    rgb_t color
+)
+{
+    if (!strip || !strip->buf || start >= strip->length || strip->palette_bits)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+    if (count == 0)
+        return;
+
+    led_strip_core_mark_dirty(strip, start, count);
+
+    LED_STRIP_STATS_T0(t0);
+
+    const size_t bpp = strip->bpp;
+    uint8_t *dst = &strip->buf[start * bpp];
+    size_t total = count * bpp;
+
+    // v * 257 puts the same byte in both halves of a 16-bit value;
+    // RGBW pixels also carry W = 0
+    if (color.r == color.g && color.g == color.b && (!strip->is_rgbw || color.r == 0)) {
+        memset(dst, color.r, total);
+        LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+        return;
+    }
+
+    if (strip->linear16) {
+        rgb16_t px = { color.r * 257u, color.g * 257u, color.b * 257u };
+        memcpy(dst, &px, sizeof(px));
+    } else {
+        dst[0] = color.r;
+        dst[1] = color.g;
+        dst[2] = color.b;
+        if (strip->is_rgbw)
+            dst[3] = 0;
+    }
+
+    for (size_t done = bpp; done < total; ) {
+        size_t chunk = done < total - done ? done : total - done;
+        memcpy(dst + done, dst, chunk);
+        done += chunk;
+    }
+
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+void led_strip_set_pixels(
+    led_strip_t *strip,
+    size_t start,
+    const rgb_t *src,
+    size_t count
+)
+{
+    _Static_assert(sizeof(rgb_t) == 3, "rgb_t must be 3 packed bytes");
+    write_span(strip, start, (const uint8_t *)src, count);
+}
+
+void led_strip_set_pixels_raw(
+    led_strip_t *strip,
+    size_t start,
+    const uint8_t *rgb,
+    size_t count
+)
+{
+    write_span(strip, start, rgb, count);
+}
+
+// ==================================================
+// Part 14 ? 16-bit linear writes
+// - Native on linear16 strips
+// - Truncated to 8 bits on regular strips
+// ==================================================
+void led_strip_set_pixel16(
+    led_strip_t *strip,
+    size_t index,
+    rgb16_t color
+)
+{
+    if (!strip || !strip->buf || index >= strip->length)
+        return;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->linear16) {
+        ((rgb16_t *)strip->buf)[index] = color;
+        led_strip_core_mark_dirty(strip, index, 1);
+    } else {
+        rgb_t c = { color.r >> 8, color.g >> 8, color.b >> 8 };
+        led_strip_core_set_pixel(strip, index, c);
+    }
+
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+void led_strip_set_pixels16(
+    led_strip_t *strip,
+    size_t start,
+    const rgb16_t *src,
+    size_t count
+)
+{
+    if (!strip || !strip->buf || !src || start >= strip->length || strip->palette_bits)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->linear16) {
+        memcpy((rgb16_t *)strip->buf + start, src, count * sizeof(rgb16_t));
+    } else {
+        const size_t bpp = strip->bpp;
+        uint8_t *dst = &strip->buf[start * bpp];
+        for (size_t i = 0; i < count; i++, dst += bpp) {
+            dst[0] = src[i].r >> 8;
+            dst[1] = src[i].g >> 8;
+            dst[2] = src[i].b >> 8;
+            if (bpp == 4)
+                dst[3] = 0;
+        }
+    }
+
+    led_strip_core_mark_dirty(strip, start, count);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
 }
 
 // ==================================================
 // Part 8 ? RGBW support (SK6812)
+// - Native on RGBW strips (W drives the white die)
+// - RGB strips get W mixed into r,g,b (saturating)
 // ==================================================
 void led_strip_set_pixel_rgbw(
     led_strip_t *strip,
@@ -186,29 +473,511 @@ void led_strip_set_pixel_rgbw(
     rgbw_t color
 )
 {
-    rgb_t mixed = {
-        .r = color.r + color.w,
-        .g = color.g + color.w,
-        .b = color.b + color.w
-    };
+    if (!strip || index >= strip->length)
+        return;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->is_rgbw)
+        led_strip_core_set_pixel_rgbw(strip, index, color);
+    else
+        led_strip_core_set_pixel(strip, index, rgbw_to_rgb(color));
 
-    led_strip_set_pixel(strip, index, mixed);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+void led_strip_set_pixels_rgbw(
+    led_strip_t *strip,
+    size_t start,
+    const rgbw_t *src,
+    size_t count
+)
+{
+    if (!strip || !strip->buf || !src || start >= strip->length || strip->palette_bits)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->is_rgbw) {
+        memcpy((rgbw_t *)strip->buf + start, src, count * sizeof(rgbw_t));
+        led_strip_core_mark_dirty(strip, start, count);
+    } else if (strip->linear16) {
+        rgb16_t *dst = (rgb16_t *)strip->buf + start;
+        for (size_t i = 0; i < count; i++) {
+            rgb_t c = rgbw_to_rgb(src[i]);
+            dst[i] = (rgb16_t){ c.r * 257u, c.g * 257u, c.b * 257u };
+        }
+        led_strip_core_mark_dirty(strip, start, count);
+    } else {
+        rgbw_to_rgb_span(src, (rgb_t *)strip->buf + start, count);
+        led_strip_core_mark_dirty(strip, start, count);
+    }
+
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
 }
 
 // ==================================================
-// Brightness + Gamma control
+// Part 18 ? HSV span writes
+// - Integer hsv_to_rgb() straight into the buffer
 // ==================================================
-void led_strip_set_brightness(uint8_t level)
+void led_strip_set_pixels_hsv(
+    led_strip_t *strip,
+    size_t start,
+    const hsv_t *src,
+    size_t count
+)
 {
-    g_brightness = level;
+    if (!strip || !strip->buf || !src || start >= strip->length || strip->palette_bits)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->linear16) {
+        rgb16_t *dst = (rgb16_t *)strip->buf + start;
+        for (size_t i = 0; i < count; i++) {
+            rgb_t c = hsv_to_rgb(src[i]);
+            dst[i] = (rgb16_t){ c.r * 257u, c.g * 257u, c.b * 257u };
+        }
+    } else if (strip->is_rgbw) {
+        rgbw_t *dst = (rgbw_t *)strip->buf + start;
+        for (size_t i = 0; i < count; i++) {
+            rgb_t c = hsv_to_rgb(src[i]);
+            dst[i] = (rgbw_t){ c.r, c.g, c.b, 0 };
+        }
+    } else {
+        hsv_to_rgb_span(src, (rgb_t *)strip->buf + start, count);
+    }
+
+    led_strip_core_mark_dirty(strip, start, count);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+// ==================================================
+// Brightness + Gamma + White balance (per strip)
+// ==================================================
+void led_strip_set_brightness(led_strip_t *strip, uint8_t level)
+{
+    if (!strip || strip->brightness == level)
+        return;
+
+    strip->brightness = level;
+    lut_rebuild(strip);
 }
 
-uint8_t led_strip_get_brightness(void)
+uint8_t led_strip_get_brightness(const led_strip_t *strip)
 {
-    return g_brightness;
+    return strip ? strip->brightness : 0;
 }
 
-void led_strip_enable_gamma(bool enable)
+void led_strip_enable_gamma(led_strip_t *strip, bool enable)
 {
-    g_gamma_enabled = enable;
-}
\ No newline at end of file
+    if (!strip || strip->gamma_enabled == enable)
+        return;
+
+    strip->gamma_enabled = enable;
+    lut_rebuild(strip);
+
+    // Power sums are kept after gamma
+    led_strip_core_mark_dirty(strip, 0, strip->length);
+}
+
+void led_strip_set_gamma_curve(led_strip_t *strip, led_gamma_t curve)
+{
+    if (!strip || curve >= LED_GAMMA_COUNT || strip->gamma_curve == curve)
+        return;
+
+    strip->gamma_curve = (uint8_t)curve;
+    if (!strip->gamma_enabled)
+        return;
+
+    lut_rebuild(strip);
+    led_strip_core_mark_dirty(strip, 0, strip->length);
+}
+
+void led_strip_set_white_balance(led_strip_t *strip, rgb_t gain)
+{
+    if (!strip)
+        return;
+
+    strip->white_balance = gain;
+    lut_rebuild(strip);
+}
+
+void led_strip_set_color_correction(led_strip_t *strip, led_correction_t correction)
+{
+    if (!strip || correction >= LED_CORRECTION_COUNT || strip->correction == correction)
+        return;
+
+    strip->correction = (uint8_t)correction;
+    lut_rebuild(strip);
+}
+
+void led_strip_set_color_temperature(led_strip_t *strip, uint16_t kelvin)
+{
+    if (!strip)
+        return;
+
+    kelvin = temperature_step(kelvin);
+    if (strip->temperature_k == kelvin)
+        return;
+
+    strip->temperature_k = kelvin;
+    lut_rebuild(strip);
+}
+
+// ==================================================
+// Part 16 ? Performance counters
+// ==================================================
+esp_err_t led_strip_get_stats(const led_strip_t *strip, led_strip_stats_t *out)
+{
+    if (!strip || !out)
+        return ESP_ERR_INVALID_ARG;
+
+#if LED_STRIP_STATS
+    *out = strip->stats;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void led_strip_reset_stats(led_strip_t *strip)
+{
+    if (!strip)
+        return;
+
+#if LED_STRIP_STATS
+    memset(&strip->stats, 0, sizeof(strip->stats));
+#endif
+}
+
+// ==================================================
+// Part 20 ? Power budget
+// estimate = idle + sum_c(sum_c * brightness * balance_c)
+//            * channel_ma / 255^3
+// sum_c is the per-channel total of gamma(v) over the
+// strip, kept per 32-pixel block and refreshed only over
+// the pixels changed since the last estimate. A frame
+// over budget gets power_scale < 255, which the LUT folds
+// into brightness: the encoder applies it, no extra pass.
+// ==================================================
+#define POWER_BLOCK 32
+
+// Block table on first use, every block stale
+static bool power_ready(led_strip_t *strip)
+{
+    if (strip->power_blocks)
+        return true;
+    if (!strip->buf)
+        return false;
+
+    size_t blocks = (strip->length + POWER_BLOCK - 1) / POWER_BLOCK;
+    strip->power_blocks = calloc(blocks, sizeof(strip->power_blocks[0]));
+    if (!strip->power_blocks)
+        return false;
+
+    memset(strip->power_sum, 0, sizeof(strip->power_sum));
+    strip->power_lo = 0;
+    strip->power_hi = strip->length;
+    return true;
+}
+
+static void power_update(led_strip_t *strip)
+{
+    if (strip->power_hi == 0)
+        return;
+
+    const uint8_t *g = gamma_curve(strip);
+    const size_t chans = strip->is_rgbw ? 4 : 3;
+    const size_t b1 = (strip->power_hi + POWER_BLOCK - 1) / POWER_BLOCK;
+
+    for (size_t b = strip->power_lo / POWER_BLOCK; b < b1; b++) {
+        size_t p0 = b * POWER_BLOCK;
+        size_t n = strip->length - p0 < POWER_BLOCK ? strip->length - p0 : POWER_BLOCK;
+        uint32_t sum[4] = { 0 };
+
+        if (strip->palette_bits) {
+            const rgb_t *pal = strip->palette;
+            for (size_t i = p0; i < p0 + n; i++) {
+                uint8_t idx = strip->palette_bits == 4
+                    ? (strip->buf[i >> 1] >> ((i & 1) * 4)) & 0x0f
+                    : strip->buf[i];
+                sum[0] += g ? g[pal[idx].r] : pal[idx].r;
+                sum[1] += g ? g[pal[idx].g] : pal[idx].g;
+                sum[2] += g ? g[pal[idx].b] : pal[idx].b;
+            }
+        } else if (strip->linear16) {
+            // High byte is close enough for an estimate
+            const uint16_t *px = (const uint16_t *)strip->buf + p0 * 3;
+            for (size_t i = 0; i < n * 3; i += 3)
+                for (size_t c = 0; c < 3; c++)
+                    sum[c] += g ? g[px[i + c] >> 8] : px[i + c] >> 8;
+        } else {
+            const uint8_t *px = strip->buf + p0 * chans;
+            for (size_t i = 0; i < n * chans; i += chans)
+                for (size_t c = 0; c < chans; c++)
+                    sum[c] += g ? g[px[i + c]] : px[i + c];
+        }
+
+        for (size_t c = 0; c < 4; c++) {
+            strip->power_sum[c] += sum[c] - strip->power_blocks[b][c];
+            strip->power_blocks[b][c] = (uint16_t)sum[c];
+        }
+    }
+
+    strip->power_lo = 0;
+    strip->power_hi = 0;
+}
+
+static uint32_t power_idle_ma(const led_strip_t *strip)
+{
+    return (uint32_t)(((uint64_t)strip->length * strip->power_idle_ua + 999) / 1000);
+}
+
+// Rounded up, at the strip's own brightness (no power scale)
+static uint32_t power_dynamic_ma(const led_strip_t *strip)
+{
+    const uint64_t full = 255u * 255u * 255u;
+    uint64_t acc = (uint64_t)strip->power_sum[0] * strip->color_gain.r
+                 + (uint64_t)strip->power_sum[1] * strip->color_gain.g
+                 + (uint64_t)strip->power_sum[2] * strip->color_gain.b
+                 + (uint64_t)strip->power_sum[3] * 255u;    // W has no balance gain
+
+    return (uint32_t)((acc * strip->brightness * strip->power_channel_ma + full - 1) / full);
+}
+
+static uint8_t power_scale_for(uint32_t budget_ma, uint32_t idle_ma, uint32_t dyn_ma)
+{
+    if (budget_ma == 0 || idle_ma + dyn_ma <= budget_ma)
+        return 255;
+    if (budget_ma <= idle_ma)
+        return 0;
+
+    return (uint8_t)((uint64_t)(budget_ma - idle_ma) * 255u / dyn_ma);
+}
+
+static void power_set_scale(led_strip_t *strip, uint8_t scale)
+{
+    if (strip->power_scale == scale)
+        return;
+
+    strip->power_scale = scale;
+    lut_rebuild(strip);
+}
+
+void led_strip_power_limit(led_strip_t *const *strips, size_t count, uint32_t budget_ma)
+{
+    if (!strips)
+        return;
+
+    uint32_t idle = 0;
+    uint32_t dyn = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        led_strip_t *s = strips[i];
+        if (!s || (!budget_ma && !s->power_budget_ma) || !power_ready(s))
+            continue;
+
+        power_update(s);
+        idle += power_idle_ma(s);
+        dyn += power_dynamic_ma(s);
+    }
+
+    const uint8_t shared = power_scale_for(budget_ma, idle, dyn);
+
+    for (size_t i = 0; i < count; i++) {
+        led_strip_t *s = strips[i];
+        if (!s)
+            continue;
+
+        uint8_t scale = shared;
+        if (s->power_budget_ma && s->power_blocks) {
+            uint8_t own = power_scale_for(s->power_budget_ma, power_idle_ma(s), power_dynamic_ma(s));
+            if (own < scale)
+                scale = own;
+        }
+
+        LED_STRIP_STATS_ADD(s, power_limited, scale < 255);
+        power_set_scale(s, scale);
+    }
+}
+
+void led_strip_set_power_budget(led_strip_t *strip, uint32_t budget_ma)
+{
+    if (!strip)
+        return;
+
+    strip->power_budget_ma = budget_ma;
+
+    // Back to full brightness right away, or applied
+    // on the next refresh
+    if (budget_ma == 0)
+        power_set_scale(strip, 255);
+    else
+        power_ready(strip);
+}
+
+void led_strip_set_power_model(led_strip_t *strip, uint16_t channel_ma, uint16_t idle_ua)
+{
+    if (!strip)
+        return;
+
+    strip->power_channel_ma = channel_ma;
+    strip->power_idle_ua = idle_ua;
+}
+
+uint32_t led_strip_get_power_ma(led_strip_t *strip)
+{
+    if (!strip || !power_ready(strip))
+        return 0;
+
+    power_update(strip);
+    return power_idle_ma(strip) + power_dynamic_ma(strip);
+}
+
+uint8_t led_strip_get_power_scale(const led_strip_t *strip)
+{
+    return strip ? strip->power_scale : 0;
+}
+
+// ==================================================
+// Part 22 ? Palette-indexed strips
+// ==================================================
+void led_strip_set_palette(
+    led_strip_t *strip,
+    size_t first,
+    const rgb_t *colors,
+    size_t count
+)
+{
+    if (!strip || !strip->palette || !colors)
+        return;
+
+    size_t entries = (size_t)1 << strip->palette_bits;
+    if (first >= entries)
+        return;
+    if (count > entries - first)
+        count = entries - first;
+
+    memcpy(strip->palette + first, colors, count * sizeof(rgb_t));
+    palette_apply(strip, first, count);
+
+    // Any pixel may use the entry: resend all, re-sum power
+    led_strip_core_mark_dirty(strip, 0, strip->length);
+}
+
+void led_strip_set_index(led_strip_t *strip, size_t index, uint8_t value)
+{
+    if (!strip || !strip->buf || !strip->palette_bits || index >= strip->length)
+        return;
+
+    LED_STRIP_STATS_T0(t0);
+
+    uint8_t *px;
+    uint8_t next;
+
+    if (strip->palette_bits == 4) {
+        const int shift = (index & 1) * 4;
+        px = &strip->buf[index >> 1];
+        next = (uint8_t)((*px & ~(0x0f << shift)) | ((value & 0x0f) << shift));
+    } else {
+        px = &strip->buf[index];
+        next = value;
+    }
+
+    if (*px != next) {
+        *px = next;
+        led_strip_core_mark_dirty(strip, index, 1);
+    }
+
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+void led_strip_set_indices(
+    led_strip_t *strip,
+    size_t start,
+    const uint8_t *src,
+    size_t count
+)
+{
+    if (!strip || !strip->buf || !strip->palette_bits || !src || start >= strip->length)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->palette_bits == 8) {
+        memcpy(strip->buf + start, src, count);
+    } else {
+        size_t i = start;
+        size_t end = start + count;
+
+        // Odd head, then whole bytes, then an even tail
+        if ((i & 1) && i < end) {
+            strip->buf[i >> 1] = (uint8_t)((strip->buf[i >> 1] & 0x0f) | (*src++ << 4));
+            i++;
+        }
+        for (; i + 1 < end; i += 2, src += 2)
+            strip->buf[i >> 1] = (uint8_t)((src[0] & 0x0f) | (src[1] << 4));
+        if (i < end)
+            strip->buf[i >> 1] = (uint8_t)((strip->buf[i >> 1] & 0xf0) | (src[0] & 0x0f));
+    }
+
+    led_strip_core_mark_dirty(strip, start, count);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+void led_strip_fill_index(led_strip_t *strip, size_t start, size_t count, uint8_t value)
+{
+    if (!strip || !strip->buf || !strip->palette_bits || start >= strip->length)
+        return;
+
+    if (count > strip->length - start)
+        count = strip->length - start;
+    if (count == 0)
+        return;
+
+    LED_STRIP_STATS_T0(t0);
+
+    if (strip->palette_bits == 8) {
+        memset(strip->buf + start, value, count);
+    } else {
+        size_t i = start;
+        size_t end = start + count;
+        uint8_t v = value & 0x0f;
+
+        if (i & 1) {
+            strip->buf[i >> 1] = (uint8_t)((strip->buf[i >> 1] & 0x0f) | (v << 4));
+            i++;
+        }
+        if (end > i + 1) {
+            size_t whole = (end - i) / 2;
+            memset(&strip->buf[i >> 1], v | (v << 4), whole);
+            i += whole * 2;
+        }
+        if (i < end)
+            strip->buf[i >> 1] = (uint8_t)((strip->buf[i >> 1] & 0xf0) | v);
+    }
+
+    led_strip_core_mark_dirty(strip, start, count);
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+}
+
+// ==================================================
+// Part 23 ? RMT refill load
+// ==================================================
+esp_err_t led_strip_get_rmt_load(const led_strip_t *strip, led_strip_rmt_load_t *out)
+{
+    if (!strip || !out)
+        return ESP_ERR_INVALID_ARG;
+
+    return led_strip_core_rmt_load(strip, out);
+}
@@ -0,0 +1,509 @@
+#include "led_strip_fx.h"
+#include "led_strip_core.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ==================================================
+// Tables (flash)
+// ==================================================
+/* Raised cosine, 0 at 0, 255 at 128 */
+static const uint8_t k_wave8[256] = {
+      0,   0,   0,   0,   1,   1,   1,   2,   2,   3,   4,   5,   5,   6,   7,   9,
+     10,  11,  12,  14,  15,  17,  18,  20,  21,  23,  25,  27,  29,  31,  33,  35,
+     37,  40,  42,  44,  47,  49,  52,  54,  57,  59,  62,  65,  67,  70,  73,  76,
+     79,  82,  85,  88,  90,  93,  97, 100, 103, 106, 109, 112, 115, 118, 121, 124,
+    127, 131, 134, 137, 140, 143, 146, 149, 152, 155, 158, 162, 165, 167, 170, 173,
+    176, 179, 182, 185, 188, 190, 193, 196, 198, 201, 203, 206, 208, 211, 213, 215,
+    218, 220, 222, 224, 226, 228, 230, 232, 234, 235, 237, 238, 240, 241, 243, 244,
+    245, 246, 248, 249, 250, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+    255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 250, 250, 249, 248, 246,
+    245, 244, 243, 241, 240, 238, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+    218, 215, 213, 211, 208, 206, 203, 201, 198, 196, 193, 190, 188, 185, 182, 179,
+    176, 173, 170, 167, 165, 162, 158, 155, 152, 149, 146, 143, 140, 137, 134, 131,
+    128, 124, 121, 118, 115, 112, 109, 106, 103, 100,  97,  93,  90,  88,  85,  82,
+     79,  76,  73,  70,  67,  65,  62,  59,  57,  54,  52,  49,  47,  44,  42,  40,
+     37,  35,  33,  31,  29,  27,  25,  23,  21,  20,  18,  17,  15,  14,  12,  11,
+     10,   9,   7,   6,   5,   5,   4,   3,   2,   2,   1,   1,   1,   0,   0,   0,
+};
+
+/* Full-saturation hue wheel, 256 steps */
+static const rgb_t k_hue_wheel[256] = {
+    { 255,   0,   0 }, { 255,   6,   0 }, { 255,  12,   0 }, { 255,  18,   0 },
+    { 255,  24,   0 }, { 255,  30,   0 }, { 255,  36,   0 }, { 255,  42,   0 },
+    { 255,  48,   0 }, { 255,  54,   0 }, { 255,  60,   0 }, { 255,  66,   0 },
+    { 255,  72,   0 }, { 255,  78,   0 }, { 255,  84,   0 }, { 255,  90,   0 },
+    { 255,  96,   0 }, { 255, 102,   0 }, { 255, 108,   0 }, { 255, 114,   0 },
+    { 255, 120,   0 }, { 255, 126,   0 }, { 255, 131,   0 }, { 255, 137,   0 },
+    { 255, 143,   0 }, { 255, 149,   0 }, { 255, 155,   0 }, { 255, 161,   0 },
+    { 255, 167,   0 }, { 255, 173,   0 }, { 255, 179,   0 }, { 255, 185,   0 },
+    { 255, 191,   0 }, { 255, 197,   0 }, { 255, 203,   0 }, { 255, 209,   0 },
+    { 255, 215,   0 }, { 255, 221,   0 }, { 255, 227,   0 }, { 255, 233,   0 },
+    { 255, 239,   0 }, { 255, 245,   0 }, { 255, 251,   0 }, { 253, 255,   0 },
+    { 247, 255,   0 }, { 241, 255,   0 }, { 235, 255,   0 }, { 229, 255,   0 },
+    { 223, 255,   0 }, { 217, 255,   0 }, { 211, 255,   0 }, { 205, 255,   0 },
+    { 199, 255,   0 }, { 193, 255,   0 }, { 187, 255,   0 }, { 181, 255,   0 },
+    { 175, 255,   0 }, { 169, 255,   0 }, { 163, 255,   0 }, { 157, 255,   0 },
+    { 151, 255,   0 }, { 145, 255,   0 }, { 139, 255,   0 }, { 133, 255,   0 },
+    { 128, 255,   0 }, { 122, 255,   0 }, { 116, 255,   0 }, { 110, 255,   0 },
+    { 104, 255,   0 }, {  98, 255,   0 }, {  92, 255,   0 }, {  86, 255,   0 },
+    {  80, 255,   0 }, {  74, 255,   0 }, {  68, 255,   0 }, {  62, 255,   0 },
+    {  56, 255,   0 }, {  50, 255,   0 }, {  44, 255,   0 }, {  38, 255,   0 },
+    {  32, 255,   0 }, {  26, 255,   0 }, {  20, 255,   0 }, {  14, 255,   0 },
+    {   8, 255,   0 }, {   2, 255,   0 }, {   0, 255,   4 }, {   0, 255,  10 },
+    {   0, 255,  16 }, {   0, 255,  22 }, {   0, 255,  28 }, {   0, 255,  34 },
+    {   0, 255,  40 }, {   0, 255,  46 }, {   0, 255,  52 }, {   0, 255,  58 },
+    {   0, 255,  64 }, {   0, 255,  70 }, {   0, 255,  76 }, {   0, 255,  82 },
+    {   0, 255,  88 }, {   0, 255,  94 }, {   0, 255, 100 }, {   0, 255, 106 },
+    {   0, 255, 112 }, {   0, 255, 118 }, {   0, 255, 124 }, {   0, 255, 129 },
+    {   0, 255, 135 }, {   0, 255, 141 }, {   0, 255, 147 }, {   0, 255, 153 },
+    {   0, 255, 159 }, {   0, 255, 165 }, {   0, 255, 171 }, {   0, 255, 177 },
+    {   0, 255, 183 }, {   0, 255, 189 }, {   0, 255, 195 }, {   0, 255, 201 },
+    {   0, 255, 207 }, {   0, 255, 213 }, {   0, 255, 219 }, {   0, 255, 225 },
+    {   0, 255, 231 }, {   0, 255, 237 }, {   0, 255, 243 }, {   0, 255, 249 },
+    {   0, 255, 255 }, {   0, 249, 255 }, {   0, 243, 255 }, {   0, 237, 255 },
+    {   0, 231, 255 }, {   0, 225, 255 }, {   0, 219, 255 }, {   0, 213, 255 },
+    {   0, 207, 255 }, {   0, 201, 255 }, {   0, 195, 255 }, {   0, 189, 255 },
+    {   0, 183, 255 }, {   0, 177, 255 }, {   0, 171, 255 }, {   0, 165, 255 },
+    {   0, 159, 255 }, {   0, 153, 255 }, {   0, 147, 255 }, {   0, 141, 255 },
+    {   0, 135, 255 }, {   0, 129, 255 }, {   0, 124, 255 }, {   0, 118, 255 },
+    {   0, 112, 255 }, {   0, 106, 255 }, {   0, 100, 255 }, {   0,  94, 255 },
+    {   0,  88, 255 }, {   0,  82, 255 }, {   0,  76, 255 }, {   0,  70, 255 },
+    {   0,  64, 255 }, {   0,  58, 255 }, {   0,  52, 255 }, {   0,  46, 255 },
+    {   0,  40, 255 }, {   0,  34, 255 }, {   0,  28, 255 }, {   0,  22, 255 },
+    {   0,  16, 255 }, {   0,  10, 255 }, {   0,   4, 255 }, {   2,   0, 255 },
+    {   8,   0, 255 }, {  14,   0, 255 }, {  20,   0, 255 }, {  26,   0, 255 },
+    {  32,   0, 255 }, {  38,   0, 255 }, {  44,   0, 255 }, {  50,   0, 255 },
+    {  56,   0, 255 }, {  62,   0, 255 }, {  68,   0, 255 }, {  74,   0, 255 },
+    {  80,   0, 255 }, {  86,   0, 255 }, {  92,   0, 255 }, {  98,   0, 255 },
+    { 104,   0, 255 }, { 110,   0, 255 }, { 116,   0, 255 }, { 122,   0, 255 },
+    { 128,   0, 255 }, { 133,   0, 255 }, { 139,   0, 255 }, { 145,   0, 255 },
+    { 151,   0, 255 }, { 157,   0, 255 }, { 163,   0, 255 }, { 169,   0, 255 },
+    { 175,   0, 255 }, { 181,   0, 255 }, { 187,   0, 255 }, { 193,   0, 255 },
+    { 199,   0, 255 }, { 205,   0, 255 }, { 211,   0, 255 }, { 217,   0, 255 },
+    { 223,   0, 255 }, { 229,   0, 255 }, { 235,   0, 255 }, { 241,   0, 255 },
+    { 247,   0, 255 }, { 253,   0, 255 }, { 255,   0, 251 }, { 255,   0, 245 },
+    { 255,   0, 239 }, { 255,   0, 233 }, { 255,   0, 227 }, { 255,   0, 221 },
+    { 255,   0, 215 }, { 255,   0, 209 }, { 255,   0, 203 }, { 255,   0, 197 },
+    { 255,   0, 191 }, { 255,   0, 185 }, { 255,   0, 179 }, { 255,   0, 173 },
+    { 255,   0, 167 }, { 255,   0, 161 }, { 255,   0, 155 }, { 255,   0, 149 },
+    { 255,   0, 143 }, { 255,   0, 137 }, { 255,   0, 131 }, { 255,   0, 126 },
+    { 255,   0, 120 }, { 255,   0, 114 }, { 255,   0, 108 }, { 255,   0, 102 },
+    { 255,   0,  96 }, { 255,   0,  90 }, { 255,   0,  84 }, { 255,   0,  78 },
+    { 255,   0,  72 }, { 255,   0,  66 }, { 255,   0,  60 }, { 255,   0,  54 },
+    { 255,   0,  48 }, { 255,   0,  42 }, { 255,   0,  36 }, { 255,   0,  30 },
+    { 255,   0,  24 }, { 255,   0,  18 }, { 255,   0,  12 }, { 255,   0,   6 },
+};
+
+/* Heat -> black, red, yellow, white */
+static const rgb_t k_heat[256] = {
+    {   0,   0,   0 }, {   0,   0,   0 }, {   4,   0,   0 }, {   8,   0,   0 },
+    {   8,   0,   0 }, {  12,   0,   0 }, {  16,   0,   0 }, {  20,   0,   0 },
+    {  20,   0,   0 }, {  24,   0,   0 }, {  28,   0,   0 }, {  32,   0,   0 },
+    {  32,   0,   0 }, {  36,   0,   0 }, {  40,   0,   0 }, {  44,   0,   0 },
+    {  44,   0,   0 }, {  48,   0,   0 }, {  52,   0,   0 }, {  56,   0,   0 },
+    {  56,   0,   0 }, {  60,   0,   0 }, {  64,   0,   0 }, {  68,   0,   0 },
+    {  68,   0,   0 }, {  72,   0,   0 }, {  76,   0,   0 }, {  80,   0,   0 },
+    {  80,   0,   0 }, {  84,   0,   0 }, {  88,   0,   0 }, {  92,   0,   0 },
+    {  92,   0,   0 }, {  96,   0,   0 }, { 100,   0,   0 }, { 104,   0,   0 },
+    { 104,   0,   0 }, { 108,   0,   0 }, { 112,   0,   0 }, { 116,   0,   0 },
+    { 116,   0,   0 }, { 120,   0,   0 }, { 124,   0,   0 }, { 128,   0,   0 },
+    { 128,   0,   0 }, { 132,   0,   0 }, { 136,   0,   0 }, { 140,   0,   0 },
+    { 140,   0,   0 }, { 144,   0,   0 }, { 148,   0,   0 }, { 152,   0,   0 },
+    { 152,   0,   0 }, { 156,   0,   0 }, { 160,   0,   0 }, { 164,   0,   0 },
+    { 164,   0,   0 }, { 168,   0,   0 }, { 172,   0,   0 }, { 176,   0,   0 },
+    { 176,   0,   0 }, { 180,   0,   0 }, { 184,   0,   0 }, { 188,   0,   0 },
+    { 188,   0,   0 }, { 192,   0,   0 }, { 196,   0,   0 }, { 200,   0,   0 },
+    { 200,   0,   0 }, { 204,   0,   0 }, { 208,   0,   0 }, { 212,   0,   0 },
+    { 212,   0,   0 }, { 216,   0,   0 }, { 220,   0,   0 }, { 224,   0,   0 },
+    { 224,   0,   0 }, { 228,   0,   0 }, { 232,   0,   0 }, { 236,   0,   0 },
+    { 236,   0,   0 }, { 240,   0,   0 }, { 244,   0,   0 }, { 248,   0,   0 },
+    { 248,   0,   0 }, { 252,   0,   0 }, { 255,   0,   0 }, { 255,   4,   0 },
+    { 255,   4,   0 }, { 255,   8,   0 }, { 255,  12,   0 }, { 255,  16,   0 },
+    { 255,  16,   0 }, { 255,  20,   0 }, { 255,  24,   0 }, { 255,  28,   0 },
+    { 255,  28,   0 }, { 255,  32,   0 }, { 255,  36,   0 }, { 255,  40,   0 },
+    { 255,  40,   0 }, { 255,  44,   0 }, { 255,  48,   0 }, { 255,  52,   0 },
+    { 255,  52,   0 }, { 255,  56,   0 }, { 255,  60,   0 }, { 255,  64,   0 },
+    { 255,  64,   0 }, { 255,  68,   0 }, { 255,  72,   0 }, { 255,  76,   0 },
+    { 255,  76,   0 }, { 255,  80,   0 }, { 255,  84,   0 }, { 255,  88,   0 },
+    { 255,  88,   0 }, { 255,  92,   0 }, { 255,  96,   0 }, { 255, 100,   0 },
+    { 255, 100,   0 }, { 255, 104,   0 }, { 255, 108,   0 }, { 255, 112,   0 },
+    { 255, 112,   0 }, { 255, 116,   0 }, { 255, 120,   0 }, { 255, 124,   0 },
+    { 255, 124,   0 }, { 255, 128,   0 }, { 255, 132,   0 }, { 255, 136,   0 },
+    { 255, 136,   0 }, { 255, 140,   0 }, { 255, 144,   0 }, { 255, 148,   0 },
+    { 255, 148,   0 }, { 255, 152,   0 }, { 255, 156,   0 }, { 255, 160,   0 },
+    { 255, 160,   0 }, { 255, 164,   0 }, { 255, 168,   0 }, { 255, 172,   0 },
+    { 255, 172,   0 }, { 255, 176,   0 }, { 255, 180,   0 }, { 255, 184,   0 },
+    { 255, 184,   0 }, { 255, 188,   0 }, { 255, 192,   0 }, { 255, 196,   0 },
+    { 255, 196,   0 }, { 255, 200,   0 }, { 255, 204,   0 }, { 255, 208,   0 },
+    { 255, 208,   0 }, { 255, 212,   0 }, { 255, 216,   0 }, { 255, 220,   0 },
+    { 255, 220,   0 }, { 255, 224,   0 }, { 255, 228,   0 }, { 255, 232,   0 },
+    { 255, 232,   0 }, { 255, 236,   0 }, { 255, 240,   0 }, { 255, 244,   0 },
+    { 255, 244,   0 }, { 255, 248,   0 }, { 255, 252,   0 }, { 255, 255,   0 },
+    { 255, 255,   0 }, { 255, 255,   4 }, { 255, 255,   8 }, { 255, 255,  12 },
+    { 255, 255,  12 }, { 255, 255,  16 }, { 255, 255,  20 }, { 255, 255,  24 },
+    { 255, 255,  24 }, { 255, 255,  28 }, { 255, 255,  32 }, { 255, 255,  36 },
+    { 255, 255,  36 }, { 255, 255,  40 }, { 255, 255,  44 }, { 255, 255,  48 },
+    { 255, 255,  48 }, { 255, 255,  52 }, { 255, 255,  56 }, { 255, 255,  60 },
+    { 255, 255,  60 }, { 255, 255,  64 }, { 255, 255,  68 }, { 255, 255,  72 },
+    { 255, 255,  72 }, { 255, 255,  76 }, { 255, 255,  80 }, { 255, 255,  84 },
+    { 255, 255,  84 }, { 255, 255,  88 }, { 255, 255,  92 }, { 255, 255,  96 },
+    { 255, 255,  96 }, { 255, 255, 100 }, { 255, 255, 104 }, { 255, 255, 108 },
+    { 255, 255, 108 }, { 255, 255, 112 }, { 255, 255, 116 }, { 255, 255, 120 },
+    { 255, 255, 120 }, { 255, 255, 124 }, { 255, 255, 128 }, { 255, 255, 132 },
+    { 255, 255, 132 }, { 255, 255, 136 }, { 255, 255, 140 }, { 255, 255, 144 },
+    { 255, 255, 144 }, { 255, 255, 148 }, { 255, 255, 152 }, { 255, 255, 156 },
+    { 255, 255, 156 }, { 255, 255, 160 }, { 255, 255, 164 }, { 255, 255, 168 },
+    { 255, 255, 168 }, { 255, 255, 172 }, { 255, 255, 176 }, { 255, 255, 180 },
+    { 255, 255, 180 }, { 255, 255, 184 }, { 255, 255, 188 }, { 255, 255, 192 },
+    { 255, 255, 192 }, { 255, 255, 196 }, { 255, 255, 200 }, { 255, 255, 204 },
+    { 255, 255, 204 }, { 255, 255, 208 }, { 255, 255, 212 }, { 255, 255, 216 },
+    { 255, 255, 216 }, { 255, 255, 220 }, { 255, 255, 224 }, { 255, 255, 228 },
+    { 255, 255, 228 }, { 255, 255, 232 }, { 255, 255, 236 }, { 255, 255, 240 },
+    { 255, 255, 240 }, { 255, 255, 244 }, { 255, 255, 248 }, { 255, 255, 252 },
+};
+
+// ==================================================
+// Helpers
+// ==================================================
+typedef struct {
+    size_t lo;
+    size_t hi;
+} fx_span_t;
+
+static inline uint32_t fx_rand(led_fx_t *fx)
+{
+    uint32_t x = fx->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    fx->rng = x;
+    return x;
+}
+
+// c * level / 256, level 255 = unchanged
+static inline rgb_t fx_scale(rgb_t c, uint8_t level)
+{
+    uint32_t l = (uint32_t)level + 1;
+    return (rgb_t){ (c.r * l) >> 8, (c.g * l) >> 8, (c.b * l) >> 8 };
+}
+
+static inline uint8_t fx_lerp(uint8_t a, uint8_t b, uint8_t t)
+{
+    return (uint8_t)(a + ((int)(b - a) * t + (b > a ? 127 : -127)) / 255);
+}
+
+static inline void fx_touch(fx_span_t *s, size_t i)
+{
+    if (i < s->lo)
+        s->lo = i;
+    if (i + 1 > s->hi)
+        s->hi = i + 1;
+}
+
+// ==================================================
+// Rainbow
+// hue(i) = phase + i * hue_step, both Q8.8
+// ==================================================
+static fx_span_t fx_rainbow(led_fx_t *fx, rgb_t *out, size_t len)
+{
+    if (!fx->full && fx->cfg.speed == 0)
+        return (fx_span_t){ 0, 0 };
+
+    uint32_t h = fx->phase;
+    const uint32_t step = fx->cfg.rainbow.hue_step;
+
+    for (size_t i = 0; i < len; i++, h += step)
+        out[i] = k_hue_wheel[(h >> 8) & 0xff];
+
+    return (fx_span_t){ 0, len };
+}
+
+// ==================================================
+// Chase
+// Blocks of size lit pixels every size + gap. Moving
+// one step darkens the pixels where blocks start and
+// lights the pixels just past their end, so a frame
+// writes 2 pixels per block per step instead of the
+// whole range.
+// ==================================================
+static fx_span_t fx_chase(led_fx_t *fx, rgb_t *out, size_t len)
+{
+    const size_t size = fx->cfg.chase.size;
+    const size_t period = size + fx->cfg.chase.gap;
+    const rgb_t on = fx->cfg.chase.on;
+    const rgb_t off = fx->cfg.chase.off;
+
+    size_t pos = (fx->phase >> 8) % period;
+    size_t steps = (pos + period - fx->last) % period;
+
+    fx->last = pos;
+
+    if (fx->full || 2 * steps >= period) {
+        // Pattern index of pixel 0
+        size_t k = (period - pos) % period;
+        for (size_t i = 0; i < len; i++) {
+            out[i] = k < size ? on : off;
+            if (++k == period)
+                k = 0;
+        }
+        return (fx_span_t){ 0, len };
+    }
+
+    fx_span_t span = { len, 0 };
+    size_t from = (pos + period - steps) % period;
+
+    for (size_t s = 0; s < steps; s++) {
+        size_t head = (from + s) % period;
+        size_t tail = (head + size) % period;
+
+        for (size_t i = head; i < len; i += period) {
+            out[i] = off;
+            fx_touch(&span, i);
+        }
+        for (size_t i = tail; i < len; i += period) {
+            out[i] = on;
+            fx_touch(&span, i);
+        }
+    }
+
+    return span;
+}
+
+// ==================================================
+// Fade
+// from -> to -> from along the raised cosine; the
+// range is only rewritten when the color changes
+// ==================================================
+static fx_span_t fx_fade(led_fx_t *fx, rgb_t *out, size_t len)
+{
+    uint8_t t = k_wave8[(fx->phase >> 8) & 0xff];
+    rgb_t from = fx->cfg.fade.from;
+    rgb_t to = fx->cfg.fade.to;
+    rgb_t c = { fx_lerp(from.r, to.r, t), fx_lerp(from.g, to.g, t), fx_lerp(from.b, to.b, t) };
+
+    uint32_t packed = ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | c.b;
+    if (!fx->full && packed == fx->last)
+        return (fx_span_t){ 0, 0 };
+    fx->last = packed;
+
+    // One pixel, then double the filled prefix
+    out[0] = c;
+    for (size_t done = 1; done < len; ) {
+        size_t chunk = done < len - done ? done : len - done;
+        memcpy(out + done, out, chunk * sizeof(rgb_t));
+        done += chunk;
+    }
+
+    return (fx_span_t){ 0, len };
+}
+
+// ==================================================
+// Twinkle
+// state = level, hue per pixel. Lit pixels decay each
+// frame, dark pixels are skipped, new sparkles start
+// at full level with a random hue.
+// ==================================================
+static fx_span_t fx_twinkle(led_fx_t *fx, rgb_t *out, size_t len)
+{
+    uint8_t *st = fx->state;
+    const uint32_t decay = fx->cfg.twinkle.decay;
+    const rgb_t black = { 0, 0, 0 };
+    fx_span_t span = { len, 0 };
+
+    for (size_t i = 0; i < len; i++, st += 2) {
+        if (st[0] == 0) {
+            if (fx->full) {
+                out[i] = black;
+                fx_touch(&span, i);
+            }
+            continue;
+        }
+
+        st[0] = (uint8_t)((st[0] * decay) >> 8);
+        out[i] = fx_scale(k_hue_wheel[st[1]], st[0]);
+        fx_touch(&span, i);
+    }
+
+    // Fractional spawn rate carried in last (per 1000 px)
+    fx->last += (uint32_t)fx->cfg.twinkle.spawn * len;
+    for (; fx->last >= 1000; fx->last -= 1000) {
+        uint32_t r = fx_rand(fx);
+        size_t i = (size_t)(((uint64_t)(r >> 8) * len) >> 24);
+
+        fx->state[2 * i] = 255;
+        fx->state[2 * i + 1] = (uint8_t)r;
+        out[i] = k_hue_wheel[(uint8_t)r];
+        fx_touch(&span, i);
+    }
+
+    return span;
+}
+
+// ==================================================
+// Fire (heat diffusion, one flame from pixel 0 up)
+// - every cell cools by a random amount
+// - heat drifts up and blurs
+// - random sparks near the base
+// - heat -> palette
+// ==================================================
+static inline uint8_t qadd8(uint8_t a, uint8_t b)
+{
+    uint32_t s = (uint32_t)a + b;
+    return s > 255 ? 255 : (uint8_t)s;
+}
+
+static inline uint8_t qsub8(uint8_t a, uint8_t b)
+{
+    return a > b ? (uint8_t)(a - b) : 0;
+}
+
+static fx_span_t fx_fire(led_fx_t *fx, rgb_t *out, size_t len)
+{
+    uint8_t *heat = fx->state;
+    const uint32_t cool_max = (uint32_t)fx->cfg.fire.cooling * 10 / len + 2;
+    uint32_t r = 0;
+
+    // 4 random bytes per xorshift
+    for (size_t i = 0; i < len; i++, r >>= 8) {
+        if ((i & 3) == 0)
+            r = fx_rand(fx);
+        heat[i] = qsub8(heat[i], (uint8_t)(((r & 0xff) * cool_max) >> 8));
+    }
+
+    // (a + 2b) / 3 as a multiply-shift
+    for (size_t k = len - 1; k >= 2; k--)
+        heat[k] = (uint8_t)(((heat[k - 1] + 2u * heat[k - 2]) * 85u) >> 8);
+
+    r = fx_rand(fx);
+    if ((r & 0xff) < fx->cfg.fire.sparking) {
+        size_t base = len < 7 ? len : 7;
+        size_t y = ((r >> 8) & 0xff) * base >> 8;
+        heat[y] = qadd8(heat[y], 160 + ((r >> 16) & 0xff) * 96 / 256);
+    }
+
+    for (size_t i = 0; i < len; i++)
+        out[i] = k_heat[heat[i]];
+
+    return (fx_span_t){ 0, len };
+}
+
+// ==================================================
+// Lifecycle
+// ==================================================
+esp_err_t led_fx_init(led_fx_t *fx, const led_strip_t *strip, const led_fx_config_t *config)
+{
+    if (!fx || !strip || !strip->buf || !config)
+        return ESP_ERR_INVALID_ARG;
+    if (config->kind > LED_FX_FIRE || config->start >= strip->length)
+        return ESP_ERR_INVALID_ARG;
+    if (config->kind == LED_FX_CHASE && config->chase.size == 0)
+        return ESP_ERR_INVALID_ARG;
+    if (strip->palette_bits)
+        return ESP_ERR_NOT_SUPPORTED;
+
+    memset(fx, 0, sizeof(*fx));
+    fx->cfg = *config;
+
+    size_t room = strip->length - config->start;
+    if (fx->cfg.length == 0 || fx->cfg.length > room)
+        fx->cfg.length = room;
+
+    size_t len = fx->cfg.length;
+    size_t state_bytes = 0;
+
+    if (config->kind == LED_FX_TWINKLE)
+        state_bytes = len * 2;
+    else if (config->kind == LED_FX_FIRE)
+        state_bytes = len;
+
+    if (state_bytes) {
+        fx->state = calloc(state_bytes, 1);
+        if (!fx->state)
+            return ESP_ERR_NO_MEM;
+    }
+
+    // Only plain 8-bit RGB buffers are rgb_t rows
+    if (strip->bpp != sizeof(rgb_t)) {
+        fx->scratch = calloc(len, sizeof(rgb_t));
+        if (!fx->scratch) {
+            led_fx_free(fx);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    fx->rng = 0x9e3779b9u ^ (uint32_t)(config->start * 2654435761u);
+    if (fx->rng == 0)
+        fx->rng = 1;
+
+    fx->full = true;
+    return ESP_OK;
+}
+
+void led_fx_free(led_fx_t *fx)
+{
+    if (!fx)
+        return;
+
+    free(fx->state);
+    free(fx->scratch);
+    fx->state = NULL;
+    fx->scratch = NULL;
+}
+
+void led_fx_restart(led_fx_t *fx)
+{
+    if (fx)
+        fx->full = true;
+}
+
+// ==================================================
+// Render
+// ==================================================
+void led_fx_render(led_strip_t *strip, led_fx_t *fx)
+{
+    if (!strip || !strip->buf || !fx || fx->cfg.length == 0)
+        return;
+
+    const size_t start = fx->cfg.start;
+    const size_t len = fx->cfg.length;
+    if (start + len > strip->length)
+        return;
+
+    LED_STRIP_STATS_T0(t0);
+
+    // buf moves on multi-buffer strips, look it up every frame
+    rgb_t *out = fx->scratch ? fx->scratch : (rgb_t *)strip->buf + start;
+    fx_span_t span;
+
+    switch (fx->cfg.kind) {
+    case LED_FX_RAINBOW: span = fx_rainbow(fx, out, len); break;
+    case LED_FX_CHASE:   span = fx_chase(fx, out, len);   break;
+    case LED_FX_FADE:    span = fx_fade(fx, out, len);    break;
+    case LED_FX_TWINKLE: span = fx_twinkle(fx, out, len); break;
+    case LED_FX_FIRE:    span = fx_fire(fx, out, len);    break;
+    default:             return;
+    }
+
+    fx->phase += fx->cfg.speed;
+    fx->full = false;
+
+    // Before the copy: set_pixels counts its own time
+    LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+
+    if (span.hi > span.lo) {
+        if (fx->scratch)
+            led_strip_set_pixels(strip, start + span.lo, fx->scratch + span.lo, span.hi - span.lo);
+        else
+            led_strip_core_mark_dirty(strip, start + span.lo, span.hi - span.lo);
+    }
+}
+
+void led_fx_render_all(led_strip_t *strip, led_fx_t *fx, size_t count)
+{
+    if (!fx)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+        led_fx_render(strip, &fx[i]);
+}
@@ -0,0 +1,199 @@
+#include "led_strip_group.h"
+#include "led_strip_core.h"
+#include "led_strip_func.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "led_strip_group"
+
+// ==================================================
+// Lifecycle
+// ==================================================
+esp_err_t led_strip_group_init(
+    led_strip_group_t *group,
+    led_strip_t *const *strips,
+    size_t count
+)
+{
+    if (!group || !strips || count == 0 || count > LED_STRIP_GROUP_MAX)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(group, 0, sizeof(*group));
+
+    rmt_channel_handle_t channels[LED_STRIP_GROUP_MAX];
+
+    for (size_t i = 0; i < count; i++) {
+        // Start sync is an RMT feature
+        if (strips[i] && strips[i]->backend != LED_STRIP_BACKEND_RMT)
+            return ESP_ERR_NOT_SUPPORTED;
+        if (!strips[i] || !strips[i]->channel)
+            return ESP_ERR_INVALID_STATE;
+
+        group->strips[i] = strips[i];
+        channels[i] = strips[i]->channel;
+    }
+    group->count = count;
+
+    // A single strip needs no hardware sync
+    if (count == 1)
+        return ESP_OK;
+
+    rmt_sync_manager_config_t sync_cfg = {
+        .tx_channel_array = channels,
+        .array_size = count,
+    };
+
+    esp_err_t err = rmt_new_sync_manager(&sync_cfg, &group->sync);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "sync manager failed (%d)", err);
+        group->count = 0;
+        return err;
+    }
+
+    return ESP_OK;
+}
+
+void led_strip_group_free(led_strip_group_t *group)
+{
+    if (!group)
+        return;
+
+    led_strip_group_wait(group, -1);
+
+    if (group->sync) {
+        rmt_del_sync_manager(group->sync);
+        group->sync = NULL;
+    }
+
+    group->count = 0;
+}
+
+// ==================================================
+// Output
+// ==================================================
+esp_err_t led_strip_group_refresh_async(led_strip_group_t *group)
+{
+    if (!group)
+        return ESP_ERR_INVALID_ARG;
+    if (group->count == 0)
+        return ESP_ERR_INVALID_STATE;
+
+    // Before the dirty check: a new power scale resends a member
+    bool limit = group->power_budget_ma != 0;
+    for (size_t i = 0; i < group->count; i++)
+        limit |= group->strips[i]->power_budget_ma != 0;
+
+    if (limit)
+        led_strip_power_limit(group->strips, group->count, group->power_budget_ma);
+
+    // linear16 members resend every frame (the dither
+    // moves), as on the single-strip path
+    bool dirty = false;
+    for (size_t i = 0; i < group->count; i++)
+        dirty |= group->strips[i]->dirty_end != 0 || group->strips[i]->linear16;
+
+    if (!dirty)
+        return ESP_OK;
+
+    // The new round starts every member together: the
+    // previous one has to be off every channel before
+    // the sync manager is re-armed
+    if (group->sync) {
+        uint32_t all = (1u << group->count) - 1;
+        if (led_strip_group_done_mask(group) != all)
+            led_strip_group_wait(group, -1);
+
+        esp_err_t err = rmt_sync_reset(group->sync);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "sync reset failed (%d)", err);
+            return err;
+        }
+    }
+
+    for (size_t i = 0; i < group->count; i++) {
+        esp_err_t err = led_strip_core_submit(group->strips[i], group->sync != NULL);
+        if (err == ESP_OK)
+            continue;
+
+        ESP_LOGE(TAG, "strip %u submit failed (%d)", (unsigned)i, err);
+
+        // The sync manager would hold the members already
+        // armed forever: drop their frames, disarm it
+        if (group->sync) {
+            for (size_t j = 0; j < i; j++)
+                led_strip_core_abort(group->strips[j]);
+            rmt_sync_reset(group->sync);
+        }
+        return err;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t led_strip_group_refresh(led_strip_group_t *group)
+{
+    esp_err_t err = led_strip_group_refresh_async(group);
+    if (err != ESP_OK)
+        return err;
+
+    // Every frame ends with its latch, done = visible
+    return led_strip_group_wait(group, -1) ? ESP_OK : ESP_FAIL;
+}
+
+bool led_strip_group_wait(led_strip_group_t *group, int timeout_ms)
+{
+    if (!group)
+        return false;
+
+    // Members finish together, so waiting one after the
+    // other costs no more than the slowest strip; one
+    // deadline for all of them, each gets what is left
+    int64_t deadline_us = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+
+    bool all_done = true;
+    for (size_t i = 0; i < group->count; i++) {
+        int remain_ms = timeout_ms;
+        if (timeout_ms > 0) {
+            int64_t remain_us = deadline_us - esp_timer_get_time();
+            remain_ms = remain_us > 0 ? (int)(remain_us / 1000) : 0;
+        }
+
+        if (led_strip_core_wait(group->strips[i], remain_ms) != ESP_OK)
+            all_done = false;
+    }
+
+    return all_done;
+}
+
+uint32_t led_strip_group_done_mask(const led_strip_group_t *group)
+{
+    if (!group)
+        return 0;
+
+    uint32_t mask = 0;
+    for (size_t i = 0; i < group->count; i++) {
+        const led_strip_t *s = group->strips[i];
+        if (s->tx_submitted == s->tx_done)
+            mask |= 1u << i;
+    }
+
+    return mask;
+}
+
+// ==================================================
+// Part 20 ? Shared power budget
+// ==================================================
+void led_strip_group_set_power_budget(led_strip_group_t *group, uint32_t budget_ma)
+{
+    if (!group)
+        return;
+
+    group->power_budget_ma = budget_ma;
+
+    // Dropping the budget lifts the shared scale now
+    if (budget_ma == 0)
+        led_strip_power_limit(group->strips, group->count, 0);
+}
@@ -0,0 +1,418 @@
+#include "led_strip_layer.h"
+#include "led_strip_core.h"
+#include "led_strip_func.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ==================================================
+// SWAR helpers
+// A word holds 4 channel bytes; every mode is the same
+// per byte, so pixels are just a byte stream. Bytes 0,2
+// and 1,3 are split into two 16-bit lane pairs so each
+// multiply / add handles two channels with headroom.
+// ==================================================
+#define LANES   0x00FF00FFu
+#define CARRY   0x01000100u
+#define ONES    0x00010001u
+
+// Unaligned-safe (multi-buffer frames are not word aligned)
+static inline uint32_t ld32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void st32(uint8_t *p, uint32_t v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+// lanes * a / 256, a = 0..256
+static inline uint32_t lanes_scale(uint32_t x, uint32_t a)
+{
+    return ((x * a) >> 8) & LANES;
+}
+
+// below * (256 - a) + layer * a, both terms < 2^16 per lane
+static inline uint32_t lanes_lerp(uint32_t d, uint32_t s, uint32_t a)
+{
+    return ((d * (256 - a) + s * a) >> 8) & LANES;
+}
+
+// Saturating add: a lane carry turns into 0xFF
+static inline uint32_t lanes_add_sat(uint32_t d, uint32_t s)
+{
+    uint32_t t = d + s;
+    t |= CARRY - ((t >> 8) & ONES);
+    return t & LANES;
+}
+
+// Bit 8 of each lane survives the subtract when d >= s
+static inline uint32_t lanes_max(uint32_t d, uint32_t s)
+{
+    uint32_t ge = (((d | CARRY) - s) >> 8) & ONES;
+    uint32_t m = ge * 0xFF;
+    return (d & m) | (s & ~m & LANES);
+}
+
+// x * y / 255, exact for 8-bit inputs
+static inline uint8_t mul_255(uint32_t x, uint32_t y)
+{
+    uint32_t p = x * y;
+    return (uint8_t)((p + 1 + (p >> 8)) >> 8);
+}
+
+// ==================================================
+// Blend kernels
+// dst = n bytes of the output row, src = n layer bytes,
+// a = opacity scaled to 0..256
+// ==================================================
+static void blend_alpha(uint8_t *dst, const uint8_t *src, size_t n, uint32_t a)
+{
+    if (a == 256) {
+        memcpy(dst, src, n);
+        return;
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t d = ld32(dst + i);
+        uint32_t s = ld32(src + i);
+        uint32_t lo = lanes_lerp(d & LANES, s & LANES, a);
+        uint32_t hi = lanes_lerp((d >> 8) & LANES, (s >> 8) & LANES, a);
+        st32(dst + i, lo | (hi << 8));
+    }
+    for (; i < n; i++)
+        dst[i] = (uint8_t)((dst[i] * (256 - a) + src[i] * a) >> 8);
+}
+
+static void blend_add(uint8_t *dst, const uint8_t *src, size_t n, uint32_t a)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t d = ld32(dst + i);
+        uint32_t s = ld32(src + i);
+        uint32_t lo = lanes_add_sat(d & LANES, lanes_scale(s & LANES, a));
+        uint32_t hi = lanes_add_sat((d >> 8) & LANES, lanes_scale((s >> 8) & LANES, a));
+        st32(dst + i, lo | (hi << 8));
+    }
+    for (; i < n; i++) {
+        uint32_t t = dst[i] + ((src[i] * a) >> 8);
+        dst[i] = t > 255 ? 255 : (uint8_t)t;
+    }
+}
+
+static void blend_max(uint8_t *dst, const uint8_t *src, size_t n, uint32_t a)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t d = ld32(dst + i);
+        uint32_t s = ld32(src + i);
+        uint32_t lo = lanes_max(d & LANES, lanes_scale(s & LANES, a));
+        uint32_t hi = lanes_max((d >> 8) & LANES, lanes_scale((s >> 8) & LANES, a));
+        st32(dst + i, lo | (hi << 8));
+    }
+    for (; i < n; i++) {
+        uint8_t s = (uint8_t)((src[i] * a) >> 8);
+        if (s > dst[i])
+            dst[i] = s;
+    }
+}
+
+// Per-byte products of two rows do not fit the lane
+// trick; the opacity lerp toward white still runs SWAR
+static void blend_multiply(uint8_t *dst, const uint8_t *src, size_t n, uint32_t a)
+{
+    const uint32_t white = LANES;
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t s = ld32(src + i);
+        uint32_t lo = lanes_lerp(white, s & LANES, a);
+        uint32_t hi = lanes_lerp(white, (s >> 8) & LANES, a);
+        uint32_t m = lo | (hi << 8);
+
+        dst[i + 0] = mul_255(dst[i + 0], m & 0xFF);
+        dst[i + 1] = mul_255(dst[i + 1], (m >> 8) & 0xFF);
+        dst[i + 2] = mul_255(dst[i + 2], (m >> 16) & 0xFF);
+        dst[i + 3] = mul_255(dst[i + 3], m >> 24);
+    }
+    for (; i < n; i++) {
+        uint32_t m = (255 * (256 - a) + src[i] * a) >> 8;
+        dst[i] = mul_255(dst[i], m);
+    }
+}
+
+// ==================================================
+// Layer lifecycle + writes
+// ==================================================
+esp_err_t led_layer_init(led_layer_t *layer, const led_strip_t *strip, const led_layer_config_t *config)
+{
+    if (!layer || !strip || !config)
+        return ESP_ERR_INVALID_ARG;
+    if (config->mode > LED_BLEND_MAX || config->start >= strip->length)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(layer, 0, sizeof(*layer));
+    layer->cfg = *config;
+
+    size_t room = strip->length - config->start;
+    if (layer->cfg.length == 0 || layer->cfg.length > room)
+        layer->cfg.length = room;
+
+    layer->pixels = calloc(layer->cfg.length, sizeof(rgb_t));
+    if (!layer->pixels)
+        return ESP_ERR_NO_MEM;
+
+    led_layer_mark_dirty(layer, 0, layer->cfg.length);
+    return ESP_OK;
+}
+
+void led_layer_free(led_layer_t *layer)
+{
+    if (!layer)
+        return;
+
+    free(layer->pixels);
+    layer->pixels = NULL;
+    layer->dirty_start = 0;
+    layer->dirty_end = 0;
+}
+
+void led_layer_mark_dirty(led_layer_t *layer, size_t start, size_t count)
+{
+    if (!layer || start >= layer->cfg.length || count == 0)
+        return;
+
+    if (count > layer->cfg.length - start)
+        count = layer->cfg.length - start;
+
+    size_t end = start + count;
+    if (layer->dirty_end == 0 || start < layer->dirty_start)
+        layer->dirty_start = start;
+    if (end > layer->dirty_end)
+        layer->dirty_end = end;
+}
+
+void led_layer_set_pixel(led_layer_t *layer, size_t index, rgb_t color)
+{
+    if (!layer || !layer->pixels || index >= layer->cfg.length)
+        return;
+
+    layer->pixels[index] = color;
+    led_layer_mark_dirty(layer, index, 1);
+}
+
+void led_layer_set_pixels(led_layer_t *layer, size_t start, const rgb_t *src, size_t count)
+{
+    if (!layer || !layer->pixels || !src || start >= layer->cfg.length)
+        return;
+
+    if (count > layer->cfg.length - start)
+        count = layer->cfg.length - start;
+
+    memcpy(layer->pixels + start, src, count * sizeof(rgb_t));
+    led_layer_mark_dirty(layer, start, count);
+}
+
+void led_layer_fill(led_layer_t *layer, size_t start, size_t count, rgb_t color)
+{
+    if (!layer || !layer->pixels || start >= layer->cfg.length)
+        return;
+
+    if (count > layer->cfg.length - start)
+        count = layer->cfg.length - start;
+    if (count == 0)
+        return;
+
+    // One pixel, then double the filled prefix
+    rgb_t *dst = layer->pixels + start;
+    dst[0] = color;
+    for (size_t done = 1; done < count; ) {
+        size_t chunk = done < count - done ? done : count - done;
+        memcpy(dst + done, dst, chunk * sizeof(rgb_t));
+        done += chunk;
+    }
+
+    led_layer_mark_dirty(layer, start, count);
+}
+
+void led_layer_set_opacity(led_layer_t *layer, uint8_t opacity)
+{
+    if (!layer || layer->cfg.opacity == opacity)
+        return;
+
+    layer->cfg.opacity = opacity;
+    led_layer_mark_dirty(layer, 0, layer->cfg.length);
+}
+
+void led_layer_set_mode(led_layer_t *layer, led_blend_t mode)
+{
+    if (!layer || mode > LED_BLEND_MAX || layer->cfg.mode == mode)
+        return;
+
+    layer->cfg.mode = mode;
+    led_layer_mark_dirty(layer, 0, layer->cfg.length);
+}
+
+// ==================================================
+// Stack
+// ==================================================
+esp_err_t led_layer_stack_init(
+    led_layer_stack_t *stack,
+    const led_strip_t *strip,
+    led_layer_t *layers,
+    size_t count
+)
+{
+    if (!stack || !strip || !strip->buf || (!layers && count))
+        return ESP_ERR_INVALID_ARG;
+    if (strip->palette_bits)
+        return ESP_ERR_NOT_SUPPORTED;
+
+    memset(stack, 0, sizeof(*stack));
+    stack->layers = layers;
+    stack->count = count;
+
+    // Only plain 8-bit RGB buffers are rgb_t rows
+    if (strip->bpp != sizeof(rgb_t)) {
+        stack->row = calloc(strip->length, sizeof(rgb_t));
+        if (!stack->row)
+            return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+void led_layer_stack_free(led_layer_stack_t *stack)
+{
+    if (!stack)
+        return;
+
+    free(stack->row);
+    stack->row = NULL;
+}
+
+// Composite [lo, hi) over black into out; every pixel
+// of the range must be covered by some layer
+static void composite_range(led_layer_stack_t *stack, rgb_t *out, size_t lo, size_t hi)
+{
+    memset(out + lo, 0, (hi - lo) * sizeof(rgb_t));
+
+    for (size_t i = 0; i < stack->count; i++) {
+        const led_layer_t *l = &stack->layers[i];
+
+        if (!l->pixels || l->cfg.opacity == 0)
+            continue;
+
+        size_t a0 = l->cfg.start > lo ? l->cfg.start : lo;
+        size_t a1 = l->cfg.start + l->cfg.length < hi ? l->cfg.start + l->cfg.length : hi;
+        if (a1 <= a0)
+            continue;
+
+        uint8_t *dst = (uint8_t *)(out + a0);
+        const uint8_t *src = (const uint8_t *)(l->pixels + (a0 - l->cfg.start));
+        size_t n = (a1 - a0) * sizeof(rgb_t);
+        uint32_t a = l->cfg.opacity + (l->cfg.opacity >> 7);
+
+        switch (l->cfg.mode) {
+        case LED_BLEND_ALPHA:    blend_alpha(dst, src, n, a);    break;
+        case LED_BLEND_ADD:      blend_add(dst, src, n, a);      break;
+        case LED_BLEND_MULTIPLY: blend_multiply(dst, src, n, a); break;
+        case LED_BLEND_MAX:      blend_max(dst, src, n, a);      break;
+        }
+    }
+}
+
+// First run of layer-covered pixels at or after pos:
+// [*start, *end), merged over overlapping / touching
+// layers. false if no layer reaches past pos.
+static bool next_covered(const led_layer_stack_t *stack, size_t pos, size_t *start, size_t *end)
+{
+    size_t s = SIZE_MAX;
+    size_t e = 0;
+
+    for (size_t i = 0; i < stack->count; i++) {
+        const led_layer_config_t *c = &stack->layers[i].cfg;
+        if (c->start + c->length <= pos)
+            continue;
+
+        size_t a = c->start > pos ? c->start : pos;
+        if (a < s || (a == s && c->start + c->length > e)) {
+            s = a;
+            e = c->start + c->length;
+        }
+    }
+
+    if (s == SIZE_MAX)
+        return false;
+
+    for (bool grew = true; grew; ) {
+        grew = false;
+        for (size_t i = 0; i < stack->count; i++) {
+            const led_layer_config_t *c = &stack->layers[i].cfg;
+            if (c->start <= e && c->start + c->length > e) {
+                e = c->start + c->length;
+                grew = true;
+            }
+        }
+    }
+
+    *start = s;
+    *end = e;
+    return true;
+}
+
+void led_layer_stack_render(led_strip_t *strip, led_layer_stack_t *stack)
+{
+    if (!strip || !strip->buf || !stack)
+        return;
+
+    // Union of the dirty ranges, strip coordinates
+    size_t lo = strip->length;
+    size_t hi = 0;
+
+    for (size_t i = 0; i < stack->count; i++) {
+        led_layer_t *l = &stack->layers[i];
+        if (l->dirty_end == 0)
+            continue;
+        if (l->cfg.start + l->dirty_start < lo)
+            lo = l->cfg.start + l->dirty_start;
+        if (l->cfg.start + l->dirty_end > hi)
+            hi = l->cfg.start + l->dirty_end;
+
+        l->dirty_start = 0;
+        l->dirty_end = 0;
+    }
+
+    if (hi > strip->length)
+        hi = strip->length;
+    if (hi <= lo)
+        return;
+
+    // buf moves on multi-buffer strips, look it up every frame
+    rgb_t *out = stack->row ? stack->row : (rgb_t *)strip->buf;
+
+    // Only pixels some layer covers: the gaps between
+    // layers keep whatever the app drew there
+    size_t a0, a1;
+    for (size_t pos = lo; pos < hi && next_covered(stack, pos, &a0, &a1); pos = a1) {
+        if (a0 >= hi)
+            break;
+        if (a1 > hi)
+            a1 = hi;
+
+        LED_STRIP_STATS_T0(t0);
+        composite_range(stack, out, a0, a1);
+
+        // Before the copy: set_pixels counts its own time
+        LED_STRIP_STATS_CYCLES(strip, write_cycles, t0);
+
+        if (stack->row)
+            led_strip_set_pixels(strip, a0, stack->row + a0, a1 - a0);
+        else
+            led_strip_core_mark_dirty(strip, a0, a1 - a0);
+    }
+}
@@ -0,0 +1,284 @@
+#include "led_strip_map.h"
+#include "led_strip_func.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==================================================
+// Helpers
+// ==================================================
+#define REVERSE_CHUNK 32
+
+// src[0] lands on strip[start + count - 1]: reversed in
+// small stack chunks so the span path still applies
+static void write_reversed(led_strip_t *strip, size_t start, const rgb_t *src, size_t count)
+{
+    rgb_t tmp[REVERSE_CHUNK];
+
+    while (count) {
+        size_t n = count < REVERSE_CHUNK ? count : REVERSE_CHUNK;
+        for (size_t i = 0; i < n; i++)
+            tmp[i] = src[n - 1 - i];
+
+        // last n pixels of the remaining range
+        led_strip_set_pixels(strip, start + count - n, tmp, n);
+        src += n;
+        count -= n;
+    }
+}
+
+// ==================================================
+// Segments
+// ==================================================
+esp_err_t led_segment_init(
+    led_segment_t *seg,
+    led_strip_t *strip,
+    size_t offset,
+    size_t length,
+    bool reverse
+)
+{
+    if (!seg || !strip || offset >= strip->length)
+        return ESP_ERR_INVALID_ARG;
+
+    size_t room = strip->length - offset;
+    if (length == 0 || length > room)
+        length = room;
+
+    seg->strip = strip;
+    seg->offset = offset;
+    seg->length = length;
+    seg->reverse = reverse;
+    return ESP_OK;
+}
+
+void led_segment_set_pixel(led_segment_t *seg, size_t index, rgb_t color)
+{
+    if (!seg || index >= seg->length)
+        return;
+
+    size_t i = seg->reverse ? seg->length - 1 - index : index;
+    led_strip_set_pixel(seg->strip, seg->offset + i, color);
+}
+
+void led_segment_set_pixels(led_segment_t *seg, size_t start, const rgb_t *src, size_t count)
+{
+    if (!seg || !src || start >= seg->length)
+        return;
+
+    if (count > seg->length - start)
+        count = seg->length - start;
+
+    if (!seg->reverse)
+        led_strip_set_pixels(seg->strip, seg->offset + start, src, count);
+    else
+        write_reversed(seg->strip, seg->offset + seg->length - start - count, src, count);
+}
+
+void led_segment_fill_range(led_segment_t *seg, size_t start, size_t count, rgb_t color)
+{
+    if (!seg || start >= seg->length)
+        return;
+
+    if (count > seg->length - start)
+        count = seg->length - start;
+
+    // A reversed range is still one contiguous strip range
+    size_t first = seg->reverse ? seg->length - start - count : start;
+    led_strip_fill_range(seg->strip, seg->offset + first, count, color);
+}
+
+void led_segment_fill(led_segment_t *seg, rgb_t color)
+{
+    if (!seg)
+        return;
+
+    led_segment_fill_range(seg, 0, seg->length, color);
+}
+
+// ==================================================
+// Matrix lifecycle
+// The layout only runs here; afterwards every access
+// is index[y * width + x]
+// ==================================================
+// Relative strip index, SIZE_MAX = unmapped
+static size_t layout_index(const led_matrix_config_t *cfg, uint16_t x, uint16_t y)
+{
+    uint16_t rel;
+
+    switch (cfg->layout) {
+    case LED_MATRIX_SERPENTINE:
+        if (y & 1)
+            x = cfg->width - 1 - x;
+        return (size_t)y * cfg->width + x;
+
+    case LED_MATRIX_CUSTOM:
+        rel = cfg->map(x, y, cfg->map_ctx);
+        return rel == LED_MATRIX_UNMAPPED ? SIZE_MAX : rel;
+
+    default:
+        return (size_t)y * cfg->width + x;
+    }
+}
+
+esp_err_t led_matrix_init(led_matrix_t *m, led_strip_t *strip, const led_matrix_config_t *config)
+{
+    if (!m || !strip || !config || config->width == 0 || config->height == 0)
+        return ESP_ERR_INVALID_ARG;
+    if (config->layout > LED_MATRIX_CUSTOM || (config->layout == LED_MATRIX_CUSTOM && !config->map))
+        return ESP_ERR_INVALID_ARG;
+
+    const size_t w = config->width;
+    const size_t h = config->height;
+
+    if (config->offset >= strip->length)
+        return ESP_ERR_INVALID_SIZE;
+
+    memset(m, 0, sizeof(*m));
+    m->index = malloc(w * h * sizeof(uint16_t));
+    m->row_step = malloc(h);
+    if (!m->index || !m->row_step) {
+        led_matrix_free(m);
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (size_t y = 0; y < h; y++) {
+        uint16_t *row = &m->index[y * w];
+
+        for (size_t x = 0; x < w; x++) {
+            size_t rel = layout_index(config, (uint16_t)x, (uint16_t)y);
+            if (rel == SIZE_MAX) {
+                row[x] = LED_MATRIX_UNMAPPED;
+                continue;
+            }
+
+            // Stored as uint16_t, UNMAPPED reserved
+            size_t i = config->offset + rel;
+            if (i >= strip->length || i >= LED_MATRIX_UNMAPPED) {
+                led_matrix_free(m);
+                return ESP_ERR_INVALID_SIZE;
+            }
+            row[x] = (uint16_t)i;
+        }
+
+        // Span row = consecutive indices one way or the other
+        int step = w > 1 && row[1] < row[0] ? -1 : 1;
+        for (size_t x = 1; x < w && step; x++)
+            if (row[x] == LED_MATRIX_UNMAPPED || (int)row[x] - (int)row[x - 1] != step)
+                step = 0;
+        if (row[0] == LED_MATRIX_UNMAPPED)
+            step = 0;
+
+        m->row_step[y] = (int8_t)step;
+    }
+
+    m->strip = strip;
+    m->width = config->width;
+    m->height = config->height;
+    return ESP_OK;
+}
+
+void led_matrix_free(led_matrix_t *m)
+{
+    if (!m)
+        return;
+
+    free(m->index);
+    free(m->row_step);
+    m->index = NULL;
+    m->row_step = NULL;
+}
+
+// ==================================================
+// Matrix drawing
+// ==================================================
+void led_matrix_set_pixel(led_matrix_t *m, uint16_t x, uint16_t y, rgb_t color)
+{
+    if (!m || !m->index || x >= m->width || y >= m->height)
+        return;
+
+    uint16_t i = led_matrix_index(m, x, y);
+    if (i != LED_MATRIX_UNMAPPED)
+        led_strip_set_pixel(m->strip, i, color);
+}
+
+// Clip [x, x + w) x [y, y + h) to the matrix; false if empty
+static bool clip_rect(const led_matrix_t *m, int *x, int *y, int *w, int *h, int *sx, int *sy)
+{
+    *sx = *x < 0 ? -*x : 0;
+    *sy = *y < 0 ? -*y : 0;
+
+    int x0 = *x + *sx;
+    int y0 = *y + *sy;
+    int x1 = *x + *w < m->width ? *x + *w : m->width;
+    int y1 = *y + *h < m->height ? *y + *h : m->height;
+
+    if (x1 <= x0 || y1 <= y0)
+        return false;
+
+    *x = x0;
+    *y = y0;
+    *w = x1 - x0;
+    *h = y1 - y0;
+    return true;
+}
+
+void led_matrix_fill_rect(
+    led_matrix_t *m,
+    int x,
+    int y,
+    int w,
+    int h,
+    rgb_t color
+)
+{
+    int sx, sy;
+    if (!m || !m->index || !clip_rect(m, &x, &y, &w, &h, &sx, &sy))
+        return;
+
+    for (int r = y; r < y + h; r++) {
+        const uint16_t *row = &m->index[(size_t)r * m->width];
+
+        if (m->row_step[r] > 0) {
+            led_strip_fill_range(m->strip, row[x], w, color);
+        } else if (m->row_step[r] < 0) {
+            led_strip_fill_range(m->strip, row[x + w - 1], w, color);
+        } else {
+            for (int c = x; c < x + w; c++)
+                if (row[c] != LED_MATRIX_UNMAPPED)
+                    led_strip_set_pixel(m->strip, row[c], color);
+        }
+    }
+}
+
+void led_matrix_blit(
+    led_matrix_t *m,
+    int x,
+    int y,
+    const rgb_t *src,
+    int w,
+    int h,
+    size_t stride
+)
+{
+    int sx, sy;
+    if (!m || !m->index || !src || !clip_rect(m, &x, &y, &w, &h, &sx, &sy))
+        return;
+
+    src += (size_t)sy * stride + sx;
+
+    for (int r = y; r < y + h; r++, src += stride) {
+        const uint16_t *row = &m->index[(size_t)r * m->width];
+
+        if (m->row_step[r] > 0) {
+            led_strip_set_pixels(m->strip, row[x], src, w);
+        } else if (m->row_step[r] < 0) {
+            write_reversed(m->strip, row[x + w - 1], src, w);
+        } else {
+            for (int c = 0; c < w; c++)
+                if (row[x + c] != LED_MATRIX_UNMAPPED)
+                    led_strip_set_pixel(m->strip, row[x + c], src[c]);
+        }
+    }
+}
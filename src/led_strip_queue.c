@@ -0,0 +1,148 @@
+#include "led_strip_queue.h"
+#include "led_strip_func.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ==================================================
+// Slot handover
+// middle = slot index | FRESH when the producer put a
+// frame there that the consumer has not taken yet.
+// Exchanges are acq_rel: the releasing side's writes
+// to its slot are visible to whoever gets it next.
+// ==================================================
+#define SLOT_MASK 0x3u
+#define FRESH     0x4u
+
+esp_err_t led_frame_queue_init(
+    led_frame_queue_t *q,
+    led_strip_t *const *strips,
+    size_t count
+)
+{
+    if (!q || !strips || count == 0 || count > LED_STRIP_GROUP_MAX)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(q, 0, sizeof(*q));
+
+    for (size_t i = 0; i < count; i++) {
+        if (!strips[i] || !strips[i]->buf)
+            return ESP_ERR_INVALID_STATE;
+        if (strips[i]->palette_bits)
+            return ESP_ERR_NOT_SUPPORTED;
+
+        q->strips[i] = strips[i];
+        q->length += strips[i]->length;
+    }
+    q->count = count;
+
+    q->slots = calloc(3 * q->length, sizeof(rgb_t));
+    if (!q->slots)
+        return ESP_ERR_NO_MEM;
+
+    q->back = 0;
+    q->front = 1;
+    atomic_init(&q->middle, 2u);
+    return ESP_OK;
+}
+
+void led_frame_queue_free(led_frame_queue_t *q)
+{
+    if (!q)
+        return;
+
+    free(q->slots);
+    q->slots = NULL;
+    q->count = 0;
+}
+
+// ==================================================
+// Producer
+// ==================================================
+rgb_t *led_frame_queue_claim(led_frame_queue_t *q)
+{
+    if (!q || !q->slots)
+        return NULL;
+
+    return q->slots + (size_t)q->back * q->length;
+}
+
+void led_frame_queue_publish(led_frame_queue_t *q)
+{
+    if (!q || !q->slots)
+        return;
+
+    unsigned old = atomic_exchange_explicit(
+        &q->middle, q->back | FRESH, memory_order_acq_rel);
+
+    // Consumer never saw the frame we just took back
+    if (old & FRESH)
+        q->dropped++;
+
+    q->back = (uint8_t)(old & SLOT_MASK);
+    q->published++;
+}
+
+// ==================================================
+// Consumer
+// ==================================================
+const rgb_t *led_frame_queue_take(led_frame_queue_t *q)
+{
+    if (!q || !q->slots)
+        return NULL;
+
+    // Cheap check first: no exchange while nothing is new
+    if (!(atomic_load_explicit(&q->middle, memory_order_acquire) & FRESH))
+        return NULL;
+
+    // Still fresh: only the producer writes middle, and
+    // every publish sets FRESH
+    unsigned old = atomic_exchange_explicit(
+        &q->middle, q->front, memory_order_acq_rel);
+
+    q->front = (uint8_t)(old & SLOT_MASK);
+    q->taken++;
+    return q->slots + (size_t)q->front * q->length;
+}
+
+// Changed range of src against the strip's RGB buffer;
+// false = identical
+static bool changed_range(const led_strip_t *strip, const rgb_t *src, size_t *start, size_t *count)
+{
+    const rgb_t *cur = (const rgb_t *)strip->buf;
+    size_t lo = 0;
+    size_t hi = strip->length;
+
+    while (lo < hi && !memcmp(&cur[lo], &src[lo], sizeof(rgb_t)))
+        lo++;
+    while (hi > lo && !memcmp(&cur[hi - 1], &src[hi - 1], sizeof(rgb_t)))
+        hi--;
+
+    *start = lo;
+    *count = hi - lo;
+    return hi > lo;
+}
+
+bool led_frame_queue_apply(led_frame_queue_t *q)
+{
+    const rgb_t *frame = led_frame_queue_take(q);
+    if (!frame)
+        return false;
+
+    for (size_t i = 0; i < q->count; i++) {
+        led_strip_t *strip = q->strips[i];
+
+        // Plain RGB buffer: compare in place, send the change only
+        if (strip->bpp == sizeof(rgb_t)) {
+            size_t start, count;
+            if (changed_range(strip, frame, &start, &count))
+                led_strip_set_pixels(strip, start, frame + start, count);
+        } else {
+            led_strip_set_pixels(strip, 0, frame, strip->length);
+        }
+
+        frame += strip->length;
+    }
+
+    return true;
+}
@@ -0,0 +1,226 @@
+#include "led_strip_sched.h"
+#include "led_strip_core.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "led_strip_sched"
+
+#define FPS_WINDOW_US        1000000
+#define DEFAULT_PRIORITY     5
+#define DEFAULT_STACK_SIZE   4096
+#define TICK_US              ((int64_t)portTICK_PERIOD_MS * 1000)
+
+// ==================================================
+// Lifecycle
+// ==================================================
+esp_err_t led_strip_sched_init(
+    led_strip_sched_t *sched,
+    const led_strip_sched_config_t *config
+)
+{
+    if (!sched || !config || !config->render)
+        return ESP_ERR_INVALID_ARG;
+
+    if (!config->strip == !config->group)
+        return ESP_ERR_INVALID_ARG;
+
+    if (config->fps == 0 || config->fps > 1000000)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(sched, 0, sizeof(*sched));
+    sched->cfg = *config;
+    sched->period_us = 1000000 / config->fps;
+
+    return ESP_OK;
+}
+
+static void sched_task(void *arg)
+{
+    led_strip_sched_t *sched = arg;
+
+    while (sched->running)
+        led_strip_sched_step(sched);
+
+    xSemaphoreGive(sched->stopped);
+    vTaskDelete(NULL);
+}
+
+esp_err_t led_strip_sched_start(led_strip_sched_t *sched)
+{
+    if (!sched || sched->period_us == 0)
+        return ESP_ERR_INVALID_ARG;
+    if (sched->task)
+        return ESP_ERR_INVALID_STATE;
+
+    sched->stopped = xSemaphoreCreateBinary();
+    if (!sched->stopped)
+        return ESP_ERR_NO_MEM;
+
+    const led_strip_sched_config_t *cfg = &sched->cfg;
+
+    sched->running = true;
+
+    BaseType_t ok = xTaskCreatePinnedToCore(
+        sched_task,
+        "led_sched",
+        cfg->stack_size ? cfg->stack_size : DEFAULT_STACK_SIZE,
+        sched,
+        cfg->priority ? cfg->priority : DEFAULT_PRIORITY,
+        &sched->task,
+        cfg->pin_core ? cfg->core_id : tskNO_AFFINITY
+    );
+
+    if (ok != pdPASS) {
+        ESP_LOGE(TAG, "task create failed (out of memory)");
+        sched->running = false;
+        sched->task = NULL;
+        vSemaphoreDelete(sched->stopped);
+        sched->stopped = NULL;
+        return ESP_ERR_NO_MEM;     // stack / TCB allocation
+    }
+
+    return ESP_OK;
+}
+
+void led_strip_sched_stop(led_strip_sched_t *sched)
+{
+    if (!sched || !sched->task)
+        return;
+
+    sched->running = false;
+    xSemaphoreTake(sched->stopped, portMAX_DELAY);
+
+    vSemaphoreDelete(sched->stopped);
+    sched->stopped = NULL;
+    sched->task = NULL;
+}
+
+// ==================================================
+// Frame helpers
+// ==================================================
+
+// Nearest tick: the grid stays exact, each wake is
+// within half a tick of its deadline
+static void sleep_until(int64_t deadline_us)
+{
+    int64_t remain = deadline_us - esp_timer_get_time();
+    if (remain <= 0)
+        return;
+
+    TickType_t ticks = (TickType_t)((remain + TICK_US / 2) / TICK_US);
+    if (ticks > 0)
+        vTaskDelay(ticks);
+}
+
+static void sched_transmit(led_strip_sched_t *sched)
+{
+    if (sched->cfg.group)
+        led_strip_group_refresh_async(sched->cfg.group);
+    else
+        led_strip_refresh_async(sched->cfg.strip);
+}
+
+// Single-buffered strips render into the frame on
+// the wire, so they must wait for it first
+static void wait_writable(led_strip_sched_t *sched)
+{
+    led_strip_group_t *group = sched->cfg.group;
+
+    if (!group) {
+        led_strip_t *strip = sched->cfg.strip;
+        if (strip->buffer_count <= 1)
+            led_strip_core_wait(strip, -1);
+        return;
+    }
+
+    for (size_t i = 0; i < group->count; i++) {
+        if (group->strips[i]->buffer_count <= 1) {
+            led_strip_group_wait(group, -1);
+            return;
+        }
+    }
+}
+
+static void sched_render(led_strip_sched_t *sched)
+{
+    int64_t start = esp_timer_get_time();
+
+    sched->cfg.render(sched->slot, sched->deadline_us, sched->cfg.ctx);
+
+    uint32_t took = (uint32_t)(esp_timer_get_time() - start);
+    if (took > sched->stats.max_render_us)
+        sched->stats.max_render_us = took;
+}
+
+// ==================================================
+// One frame
+// ==================================================
+esp_err_t led_strip_sched_step(led_strip_sched_t *sched)
+{
+    if (!sched || sched->period_us == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    // First call: render frame 0, it goes out at once
+    if (!sched->primed) {
+        sched->slot = 0;
+        sched->deadline_us = esp_timer_get_time();
+        sched_render(sched);
+        sched->deadline_us = esp_timer_get_time();
+        sched->window_start_us = sched->deadline_us;
+        sched->primed = true;
+    }
+
+    int64_t late = esp_timer_get_time() - sched->deadline_us;
+
+    if (late > TICK_US) {
+        sched->stats.late++;
+
+        if (sched->cfg.policy == LED_STRIP_SCHED_COALESCE) {
+            sched->stats.dropped += (uint32_t)(late / sched->period_us);
+            sched->deadline_us += late;
+        } else {
+            int64_t missed = (late + sched->period_us - 1) / sched->period_us;
+            sched->stats.dropped += (uint32_t)missed;
+            sched->deadline_us += missed * sched->period_us;
+            sched->slot += (uint32_t)missed;
+        }
+    }
+
+    sleep_until(sched->deadline_us);
+    sched_transmit(sched);
+
+    // Achieved rate over roughly one second
+    int64_t now = esp_timer_get_time();
+
+    sched->stats.frames++;
+    sched->window_frames++;
+
+    int64_t span = now - sched->window_start_us;
+    if (span >= FPS_WINDOW_US) {
+        sched->stats.fps_milli = (uint32_t)((uint64_t)sched->window_frames * 1000000000ULL / span);
+        sched->window_start_us = now;
+        sched->window_frames = 0;
+    }
+
+    sched->deadline_us += sched->period_us;
+    sched->slot++;
+
+    wait_writable(sched);
+    sched_render(sched);
+
+    return ESP_OK;
+}
+
+void led_strip_sched_get_stats(
+    const led_strip_sched_t *sched,
+    led_strip_sched_stats_t *out
+)
+{
+    if (!sched || !out)
+        return;
+
+    *out = sched->stats;
+}
@@ -0,0 +1,225 @@
+#include "led_strip_core.h"
+#include "led_strip.h"
+
+#include <string.h>
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+#define TAG "led_strip_spi"
+
+/* =================================================
+   SPI BACKEND
+
+   - MOSI alone carries the WS2812 waveform: 4 SPI
+     bits per LED bit at 3.2 MHz (312.5 ns each),
+     "1000" = 0, "1110" / "1100" = 1
+   - The strip's stage kernel (LUT + order, any pixel
+     format) fills a small stack chunk, which a const
+     256-entry table expands to 4 SPI bytes per wire
+     byte straight into the DMA buffer
+   - The latch is sent as zero bytes at the end of the
+     same transaction
+   - Runs in the caller's task: the DMA buffer holds
+     the whole frame, so there is no refill interrupt
+==================================================*/
+
+#define CHECK(x)     do { esp_err_t r = (x); if (r != ESP_OK) return r; } while (0)
+#define CHECK_ARG(x) do { if (!(x)) return ESP_ERR_INVALID_ARG; } while (0)
+
+#define SPI_CLOCK_HZ    (3200 * 1000)
+#define SPI_STAGE_PX    32      /* pixels staged per expansion */
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "SPI expansion tables assume a little-endian CPU"
+#endif
+
+/* =================================================
+   Expansion tables
+
+   Built by the preprocessor: LED bit n of byte v ->
+   nibble p0 / p1, two nibbles per SPI byte, MSB first.
+   Each entry is the 4 SPI bytes in memory order, so
+   one 32-bit store puts a wire byte in the buffer.
+==================================================*/
+#define SPI_BIT(v, n, p0, p1)  ((((v) >> (n)) & 1) ? (p1) : (p0))
+#define SPI_PAIR(v, n, p0, p1) ((uint32_t)(SPI_BIT(v, n, p0, p1) << 4 | SPI_BIT(v, (n) - 1, p0, p1)))
+
+#define SPI_WORD(v, p0, p1) (                   \
+    SPI_PAIR(v, 7, p0, p1)       |              \
+    SPI_PAIR(v, 5, p0, p1) << 8  |              \
+    SPI_PAIR(v, 3, p0, p1) << 16 |              \
+    SPI_PAIR(v, 1, p0, p1) << 24)
+
+#define SPI_ROW4(v, p0, p1)                     \
+    SPI_WORD((v) + 0, p0, p1), SPI_WORD((v) + 1, p0, p1), \
+    SPI_WORD((v) + 2, p0, p1), SPI_WORD((v) + 3, p0, p1)
+#define SPI_ROW16(v, p0, p1)                    \
+    SPI_ROW4((v) + 0, p0, p1), SPI_ROW4((v) + 4, p0, p1), \
+    SPI_ROW4((v) + 8, p0, p1), SPI_ROW4((v) + 12, p0, p1)
+#define SPI_ROW64(v, p0, p1)                    \
+    SPI_ROW16((v) + 0, p0, p1), SPI_ROW16((v) + 16, p0, p1), \
+    SPI_ROW16((v) + 32, p0, p1), SPI_ROW16((v) + 48, p0, p1)
+#define SPI_TABLE(p0, p1) {                     \
+    SPI_ROW64(0, p0, p1), SPI_ROW64(64, p0, p1), \
+    SPI_ROW64(128, p0, p1), SPI_ROW64(192, p0, p1) }
+
+/* WS2812: T0H 312 ns, T1H 937 ns */
+static const uint32_t k_expand_ws2812[256] = SPI_TABLE(0x8, 0xE);
+
+/* SK6812: T0H 312 ns, T1H 625 ns */
+static const uint32_t k_expand_sk6812[256] = SPI_TABLE(0x8, 0xC);
+
+static inline void spi_expand(const uint32_t *table, const uint8_t *src, size_t n, uint32_t *dst)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        dst[i + 0] = table[src[i + 0]];
+        dst[i + 1] = table[src[i + 1]];
+        dst[i + 2] = table[src[i + 2]];
+        dst[i + 3] = table[src[i + 3]];
+    }
+    for (; i < n; i++)
+        dst[i] = table[src[i]];
+}
+
+/* =================================================
+   TX DONE (ISR)
+==================================================*/
+static void IRAM_ATTR on_trans_done(spi_transaction_t *trans)
+{
+    if (led_strip_core_frame_done(trans->user))
+        portYIELD_FROM_ISR();
+}
+
+/* =================================================
+   INIT / FREE
+==================================================*/
+esp_err_t led_strip_spi_init(led_strip_t *strip, uint32_t reset_us)
+{
+    CHECK_ARG(strip && strip->length > 0 && strip->stage);
+
+    size_t wire_bpp = strip->is_rgbw ? 4 : 3;
+
+    /* Latch: reset_us of zero bits, whole words */
+    size_t latch = ((size_t)reset_us * (SPI_CLOCK_HZ / 1000000) + 31) / 32 * 4;
+    size_t bytes = strip->length * wire_bpp * 4 + latch;
+
+    strip->spi_table = strip->type == LED_STRIP_SK6812 ? k_expand_sk6812 : k_expand_ws2812;
+    strip->spi_latch = latch;
+    strip->spi_pending = false;
+
+    strip->spi_buf = heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+    if (!strip->spi_buf)
+        return ESP_ERR_NO_MEM;
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = strip->gpio,
+        .miso_io_num = -1,
+        .sclk_io_num = -1,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = (int)bytes,
+    };
+
+    CHECK(spi_bus_initialize(strip->spi_host, &bus_cfg, SPI_DMA_CH_AUTO));
+
+    spi_device_interface_config_t dev_cfg = {
+        .mode = 0,
+        .clock_speed_hz = SPI_CLOCK_HZ,
+        .spics_io_num = -1,
+        .queue_size = 1,
+        .post_cb = on_trans_done,
+    };
+
+    esp_err_t err = spi_bus_add_device(strip->spi_host, &dev_cfg, &strip->spi);
+    if (err != ESP_OK) {
+        spi_bus_free(strip->spi_host);
+        strip->spi = NULL;
+        return err;
+    }
+
+    ESP_LOGI(TAG, "SPI output on host %d, %zu byte DMA buffer", (int)strip->spi_host, bytes);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_spi_free(led_strip_t *strip)
+{
+    CHECK_ARG(strip);
+
+    if (strip->spi) {
+        led_strip_spi_wait(strip, -1);
+        spi_bus_remove_device(strip->spi);
+        spi_bus_free(strip->spi_host);
+        strip->spi = NULL;
+    }
+
+    heap_caps_free(strip->spi_buf);
+    strip->spi_buf = NULL;
+    return ESP_OK;
+}
+
+/* =================================================
+   TRANSMIT
+==================================================*/
+esp_err_t led_strip_spi_transmit(led_strip_t *strip, size_t pixels)
+{
+    CHECK_ARG(strip && strip->spi && pixels <= strip->length);
+
+    /* One DMA buffer: the previous frame has to be out */
+    CHECK(led_strip_spi_wait(strip, -1));
+
+    LED_STRIP_STATS_T0(t0);
+
+    const size_t wire_bpp = strip->is_rgbw ? 4 : 3;
+    uint8_t stage[SPI_STAGE_PX * 4];
+    uint32_t *dst = strip->spi_buf;
+
+    for (size_t first = 0; first < pixels; ) {
+        size_t n = pixels - first < SPI_STAGE_PX ? pixels - first : SPI_STAGE_PX;
+
+        strip->stage(strip, strip->buf, first, n, stage);
+        spi_expand(strip->spi_table, stage, n * wire_bpp, dst);
+
+        dst += n * wire_bpp;
+        first += n;
+    }
+
+    memset(dst, 0, strip->spi_latch);
+
+#if LED_STRIP_STATS
+    LED_STRIP_STATS_CYCLES(strip, encode_cycles, t0);
+    led_strip_hist_add(&strip->stats.encode, led_strip_cycles_to_us(strip->encode_cycles));
+    strip->encode_cycles = 0;
+#endif
+
+    size_t bytes = pixels * wire_bpp * 4 + strip->spi_latch;
+
+    strip->spi_trans = (spi_transaction_t){
+        .length = bytes * 8,
+        .tx_buffer = strip->spi_buf,
+        .user = strip,
+    };
+
+    CHECK(spi_device_queue_trans(strip->spi, &strip->spi_trans, portMAX_DELAY));
+    strip->spi_pending = true;
+    return ESP_OK;
+}
+
+/* timeout_ms < 0 = forever, 0 = poll */
+esp_err_t led_strip_spi_wait(led_strip_t *strip, int timeout_ms)
+{
+    CHECK_ARG(strip && strip->spi);
+
+    if (!strip->spi_pending)
+        return ESP_OK;
+
+    spi_transaction_t *done;
+    TickType_t ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+
+    CHECK(spi_device_get_trans_result(strip->spi, &done, ticks));
+    strip->spi_pending = false;
+    return ESP_OK;
+}
@@ -0,0 +1,344 @@
+// Generated by tools/gen_tables.py, do not edit
+// Custom gamma exponent: 2.0
+
+#include "led_strip_tables.h"
+
+_Static_assert(LED_GAMMA_COUNT == 5, "gamma curves out of sync with tools/gen_tables.py");
+_Static_assert(LED_CORRECTION_COUNT == 3, "corrections out of sync with tools/gen_tables.py");
+_Static_assert(LED_TEMPERATURE_STEPS == 111, "temperatures out of sync with tools/gen_tables.py");
+
+const uint8_t led_gamma8[LED_GAMMA_COUNT][256] = {
+    {   // 2.2
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+          1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+          3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+          6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+         12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+         20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+         30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+         42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+         56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+         73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+         91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+        113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+        137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+        163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+        192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+        223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+    },
+    {   // 2.5
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+          1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   4,   4,
+          4,   4,   4,   5,   5,   5,   5,   6,   6,   6,   6,   7,   7,   7,   7,   8,
+          8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  12,  12,  12,  13,  13,  14,
+         14,  15,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  22,
+         22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,  30,  30,  31,  32,
+         33,  33,  34,  35,  36,  36,  37,  38,  39,  40,  40,  41,  42,  43,  44,  45,
+         46,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,
+         61,  62,  63,  64,  65,  67,  68,  69,  70,  71,  72,  73,  75,  76,  77,  78,
+         80,  81,  82,  83,  85,  86,  87,  89,  90,  91,  93,  94,  95,  97,  98,  99,
+        101, 102, 104, 105, 107, 108, 110, 111, 113, 114, 116, 117, 119, 121, 122, 124,
+        125, 127, 129, 130, 132, 134, 135, 137, 139, 141, 142, 144, 146, 148, 150, 151,
+        153, 155, 157, 159, 161, 163, 165, 166, 168, 170, 172, 174, 176, 178, 180, 182,
+        184, 186, 189, 191, 193, 195, 197, 199, 201, 204, 206, 208, 210, 212, 215, 217,
+        219, 221, 224, 226, 228, 231, 233, 235, 238, 240, 243, 245, 248, 250, 253, 255,
+    },
+    {   // 2.8
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+          1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+          2,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   5,   5,   5,
+          5,   6,   6,   6,   6,   7,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,
+         10,  10,  11,  11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,
+         17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  24,  24,  25,
+         25,  26,  27,  27,  28,  29,  29,  30,  31,  32,  32,  33,  34,  35,  35,  36,
+         37,  38,  39,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  50,
+         51,  52,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  66,  67,  68,
+         69,  70,  72,  73,  74,  75,  77,  78,  79,  81,  82,  83,  85,  86,  87,  89,
+         90,  92,  93,  95,  96,  98,  99, 101, 102, 104, 105, 107, 109, 110, 112, 114,
+        115, 117, 119, 120, 122, 124, 126, 127, 129, 131, 133, 135, 137, 138, 140, 142,
+        144, 146, 148, 150, 152, 154, 156, 158, 160, 162, 164, 167, 169, 171, 173, 175,
+        177, 180, 182, 184, 186, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+        215, 218, 220, 223, 225, 228, 231, 233, 236, 239, 241, 244, 247, 249, 252, 255,
+    },
+    {   // sRGB
+          0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+          1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,
+          4,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,   6,   7,   7,   7,
+          8,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  12,  12,  12,  13,
+         13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  17,  18,  18,  19,  19,  20,
+         20,  21,  22,  22,  23,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+         30,  30,  31,  32,  32,  33,  34,  35,  35,  36,  37,  37,  38,  39,  40,  41,
+         41,  42,  43,  44,  45,  45,  46,  47,  48,  49,  50,  51,  51,  52,  53,  54,
+         55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,
+         71,  72,  73,  74,  76,  77,  78,  79,  80,  81,  82,  84,  85,  86,  87,  88,
+         90,  91,  92,  93,  95,  96,  97,  99, 100, 101, 103, 104, 105, 107, 108, 109,
+        111, 112, 114, 115, 116, 118, 119, 121, 122, 124, 125, 127, 128, 130, 131, 133,
+        134, 136, 138, 139, 141, 142, 144, 146, 147, 149, 151, 152, 154, 156, 157, 159,
+        161, 163, 164, 166, 168, 170, 171, 173, 175, 177, 179, 181, 183, 184, 186, 188,
+        190, 192, 194, 196, 198, 200, 202, 204, 206, 208, 210, 212, 214, 216, 218, 220,
+        222, 224, 226, 229, 231, 233, 235, 237, 239, 242, 244, 246, 248, 250, 253, 255,
+    },
+    {   // custom
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+          1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   4,   4,
+          4,   4,   5,   5,   5,   5,   6,   6,   6,   7,   7,   7,   8,   8,   8,   9,
+          9,   9,  10,  10,  11,  11,  11,  12,  12,  13,  13,  14,  14,  15,  15,  16,
+         16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  23,  23,  24,  24,
+         25,  26,  26,  27,  28,  28,  29,  30,  30,  31,  32,  32,  33,  34,  35,  35,
+         36,  37,  38,  38,  39,  40,  41,  42,  42,  43,  44,  45,  46,  47,  47,  48,
+         49,  50,  51,  52,  53,  54,  55,  56,  56,  57,  58,  59,  60,  61,  62,  63,
+         64,  65,  66,  67,  68,  69,  70,  71,  73,  74,  75,  76,  77,  78,  79,  80,
+         81,  82,  84,  85,  86,  87,  88,  89,  91,  92,  93,  94,  95,  97,  98,  99,
+        100, 102, 103, 104, 105, 107, 108, 109, 111, 112, 113, 115, 116, 117, 119, 120,
+        121, 123, 124, 126, 127, 128, 130, 131, 133, 134, 136, 137, 139, 140, 142, 143,
+        145, 146, 148, 149, 151, 152, 154, 155, 157, 158, 160, 162, 163, 165, 166, 168,
+        170, 171, 173, 175, 176, 178, 180, 181, 183, 185, 186, 188, 190, 192, 193, 195,
+        197, 199, 200, 202, 204, 206, 207, 209, 211, 213, 215, 217, 218, 220, 222, 224,
+        226, 228, 230, 232, 233, 235, 237, 239, 241, 243, 245, 247, 249, 251, 253, 255,
+    },
+};
+
+const uint16_t led_gamma16[LED_GAMMA_COUNT][257] = {
+    {   // 2.2
+            0,     0,     2,     4,     7,    11,    17,    24,    32,    41,    52,    64,
+           78,    93,   110,   128,   147,   168,   191,   215,   240,   267,   296,   327,
+          359,   392,   428,   465,   504,   544,   586,   630,   676,   723,   772,   823,
+          875,   930,   986,  1044,  1104,  1165,  1229,  1294,  1361,  1430,  1501,  1574,
+         1648,  1725,  1803,  1884,  1966,  2050,  2136,  2224,  2314,  2406,  2500,  2595,
+         2693,  2793,  2895,  2998,  3104,  3212,  3322,  3433,  3547,  3663,  3781,  3900,
+         4022,  4146,  4272,  4400,  4530,  4663,  4797,  4933,  5072,  5212,  5355,  5499,
+         5646,  5795,  5946,  6099,  6255,  6412,  6572,  6733,  6897,  7063,  7231,  7402,
+         7574,  7749,  7926,  8105,  8286,  8469,  8655,  8843,  9033,  9225,  9419,  9616,
+         9815, 10016, 10219, 10425, 10632, 10842, 11054, 11269, 11486, 11705, 11926, 12149,
+        12375, 12603, 12833, 13066, 13301, 13538, 13777, 14019, 14263, 14509, 14758, 15009,
+        15262, 15517, 15775, 16035, 16298, 16563, 16830, 17099, 17371, 17645, 17922, 18201,
+        18482, 18765, 19051, 19339, 19630, 19923, 20218, 20516, 20816, 21119, 21424, 21731,
+        22040, 22352, 22667, 22984, 23303, 23624, 23949, 24275, 24604, 24935, 25269, 25605,
+        25943, 26284, 26628, 26973, 27322, 27672, 28026, 28381, 28739, 29100, 29462, 29828,
+        30196, 30566, 30939, 31314, 31692, 32072, 32454, 32840, 33227, 33617, 34010, 34405,
+        34802, 35202, 35605, 36010, 36417, 36827, 37240, 37655, 38072, 38493, 38915, 39340,
+        39768, 40198, 40631, 41066, 41503, 41944, 42387, 42832, 43280, 43730, 44183, 44639,
+        45097, 45557, 46020, 46486, 46954, 47425, 47899, 48374, 48853, 49334, 49818, 50304,
+        50793, 51284, 51778, 52275, 52774, 53276, 53780, 54287, 54796, 55308, 55823, 56341,
+        56860, 57383, 57908, 58436, 58966, 59499, 60035, 60573, 61114, 61657, 62203, 62752,
+        63303, 63857, 64414, 64973, 65535,
+    },
+    {   // 2.5
+            0,     0,     0,     1,     2,     3,     6,     8,    11,    15,    20,    25,
+           31,    38,    46,    54,    64,    74,    86,    98,   112,   126,   142,   159,
+          176,   195,   215,   237,   259,   283,   308,   334,   362,   391,   421,   453,
+          486,   520,   556,   594,   632,   673,   714,   758,   803,   849,   897,   946,
+          998,  1050,  1105,  1161,  1219,  1278,  1339,  1402,  1467,  1533,  1601,  1671,
+         1743,  1816,  1892,  1969,  2048,  2129,  2212,  2296,  2383,  2472,  2562,  2655,
+         2749,  2846,  2944,  3045,  3147,  3252,  3358,  3467,  3578,  3691,  3805,  3923,
+         4042,  4163,  4287,  4412,  4540,  4670,  4803,  4937,  5074,  5213,  5354,  5498,
+         5644,  5792,  5942,  6095,  6250,  6407,  6567,  6729,  6894,  7061,  7230,  7402,
+         7576,  7752,  7931,  8113,  8297,  8483,  8672,  8864,  9058,  9254,  9453,  9655,
+         9859, 10066, 10275, 10487, 10701, 10918, 11138, 11360, 11585, 11813, 12043, 12276,
+        12511, 12750, 12991, 13235, 13481, 13730, 13982, 14237, 14494, 14754, 15017, 15283,
+        15552, 15823, 16097, 16374, 16654, 16937, 17223, 17511, 17803, 18097, 18394, 18694,
+        18997, 19303, 19612, 19924, 20238, 20556, 20877, 21200, 21527, 21857, 22189, 22525,
+        22864, 23205, 23550, 23898, 24249, 24603, 24960, 25320, 25684, 26050, 26419, 26792,
+        27168, 27547, 27929, 28314, 28702, 29094, 29489, 29887, 30288, 30692, 31100, 31511,
+        31925, 32342, 32763, 33186, 33613, 34044, 34478, 34915, 35355, 35798, 36245, 36696,
+        37149, 37606, 38066, 38530, 38997, 39467, 39941, 40418, 40899, 41383, 41870, 42361,
+        42856, 43353, 43855, 44359, 44867, 45379, 45894, 46413, 46935, 47460, 47989, 48522,
+        49058, 49598, 50141, 50688, 51238, 51792, 52350, 52911, 53475, 54044, 54615, 55191,
+        55770, 56353, 56939, 57529, 58123, 58720, 59321, 59926, 60534, 61147, 61762, 62382,
+        63005, 63632, 64263, 64897, 65535,
+    },
+    {   // 2.8
+            0,     0,     0,     0,     1,     1,     2,     3,     4,     6,     7,    10,
+           12,    16,    19,    23,    28,    33,    39,    45,    52,    60,    68,    77,
+           87,    97,   108,   121,   133,   147,   162,   178,   194,   211,   230,   249,
+          270,   291,   314,   338,   362,   388,   415,   444,   473,   504,   536,   569,
+          604,   640,   677,   715,   755,   797,   840,   884,   930,   977,  1026,  1076,
+         1128,  1181,  1236,  1293,  1351,  1411,  1473,  1536,  1601,  1668,  1737,  1807,
+         1879,  1953,  2029,  2107,  2186,  2268,  2351,  2436,  2524,  2613,  2704,  2798,
+         2893,  2991,  3090,  3192,  3296,  3402,  3510,  3620,  3733,  3847,  3964,  4083,
+         4205,  4329,  4455,  4583,  4714,  4847,  4983,  5121,  5261,  5404,  5550,  5697,
+         5848,  6001,  6156,  6314,  6475,  6638,  6804,  6972,  7143,  7317,  7493,  7672,
+         7854,  8039,  8226,  8417,  8610,  8805,  9004,  9206,  9410,  9617,  9827, 10041,
+        10257, 10476, 10698, 10923, 11151, 11382, 11616, 11853, 12094, 12337, 12584, 12833,
+        13086, 13342, 13602, 13864, 14130, 14399, 14671, 14946, 15225, 15507, 15793, 16082,
+        16374, 16669, 16968, 17271, 17577, 17886, 18199, 18515, 18835, 19158, 19485, 19816,
+        20150, 20487, 20829, 21173, 21522, 21874, 22230, 22590, 22953, 23320, 23691, 24065,
+        24444, 24826, 25212, 25601, 25995, 26393, 26794, 27199, 27609, 28022, 28439, 28860,
+        29285, 29714, 30147, 30584, 31025, 31471, 31920, 32374, 32831, 33293, 33759, 34229,
+        34703, 35181, 35664, 36151, 36642, 37137, 37637, 38141, 38649, 39162, 39679, 40200,
+        40726, 41256, 41791, 42330, 42873, 43421, 43973, 44530, 45092, 45658, 46228, 46803,
+        47383, 47967, 48556, 49149, 49747, 50350, 50957, 51569, 52186, 52808, 53434, 54065,
+        54701, 55341, 55987, 56637, 57292, 57952, 58616, 59286, 59961, 60640, 61324, 62014,
+        62708, 63407, 64111, 64821, 65535,
+    },
+    {   // sRGB
+            0,    20,    40,    59,    79,    99,   119,   139,   159,   178,   198,   218,
+          240,   263,   286,   312,   338,   365,   394,   424,   456,   489,   523,   558,
+          595,   633,   673,   714,   756,   800,   845,   892,   940,   990,  1041,  1094,
+         1148,  1204,  1262,  1320,  1381,  1443,  1507,  1572,  1639,  1707,  1778,  1849,
+         1923,  1998,  2075,  2154,  2234,  2316,  2400,  2485,  2572,  2661,  2752,  2845,
+         2939,  3035,  3133,  3233,  3334,  3438,  3543,  3650,  3759,  3870,  3982,  4097,
+         4214,  4332,  4452,  4575,  4699,  4825,  4953,  5083,  5215,  5349,  5485,  5623,
+         5763,  5906,  6050,  6196,  6344,  6494,  6646,  6800,  6957,  7115,  7276,  7438,
+         7603,  7770,  7939,  8110,  8283,  8458,  8636,  8816,  8997,  9181,  9367,  9556,
+         9746,  9939, 10134, 10331, 10530, 10732, 10936, 11142, 11350, 11561, 11773, 11988,
+        12206, 12425, 12647, 12872, 13098, 13327, 13558, 13791, 14027, 14265, 14506, 14749,
+        14994, 15241, 15491, 15743, 15998, 16255, 16514, 16776, 17041, 17307, 17576, 17848,
+        18122, 18398, 18677, 18958, 19242, 19528, 19816, 20108, 20401, 20697, 20996, 21297,
+        21600, 21906, 22215, 22526, 22840, 23156, 23474, 23796, 24119, 24446, 24775, 25106,
+        25440, 25777, 26116, 26458, 26802, 27149, 27499, 27851, 28206, 28563, 28923, 29286,
+        29651, 30019, 30390, 30763, 31139, 31518, 31899, 32283, 32670, 33059, 33451, 33846,
+        34243, 34644, 35046, 35452, 35860, 36271, 36685, 37102, 37521, 37943, 38368, 38795,
+        39226, 39659, 40095, 40533, 40975, 41419, 41866, 42316, 42768, 43224, 43682, 44143,
+        44607, 45073, 45543, 46015, 46491, 46969, 47450, 47934, 48420, 48910, 49402, 49897,
+        50396, 50897, 51401, 51908, 52417, 52930, 53446, 53964, 54486, 55010, 55537, 56067,
+        56601, 57137, 57676, 58218, 58763, 59311, 59862, 60415, 60972, 61532, 62095, 62661,
+        63230, 63801, 64376, 64954, 65535,
+    },
+    {   // custom
+            0,     1,     4,     9,    16,    25,    36,    49,    64,    81,   100,   121,
+          144,   169,   196,   225,   256,   289,   324,   361,   400,   441,   484,   529,
+          576,   625,   676,   729,   784,   841,   900,   961,  1024,  1089,  1156,  1225,
+         1296,  1369,  1444,  1521,  1600,  1681,  1764,  1849,  1936,  2025,  2116,  2209,
+         2304,  2401,  2500,  2601,  2704,  2809,  2916,  3025,  3136,  3249,  3364,  3481,
+         3600,  3721,  3844,  3969,  4096,  4225,  4356,  4489,  4624,  4761,  4900,  5041,
+         5184,  5329,  5476,  5625,  5776,  5929,  6084,  6241,  6400,  6561,  6724,  6889,
+         7056,  7225,  7396,  7569,  7744,  7921,  8100,  8281,  8464,  8649,  8836,  9025,
+         9216,  9409,  9604,  9801, 10000, 10201, 10404, 10609, 10816, 11025, 11236, 11449,
+        11664, 11881, 12100, 12321, 12544, 12769, 12996, 13225, 13456, 13689, 13924, 14161,
+        14400, 14641, 14884, 15129, 15376, 15625, 15876, 16129, 16384, 16641, 16900, 17161,
+        17424, 17689, 17956, 18225, 18496, 18769, 19044, 19321, 19600, 19881, 20164, 20449,
+        20736, 21025, 21316, 21609, 21904, 22201, 22500, 22801, 23104, 23409, 23716, 24025,
+        24336, 24649, 24964, 25281, 25600, 25921, 26244, 26569, 26896, 27225, 27556, 27889,
+        28224, 28561, 28900, 29241, 29584, 29929, 30276, 30625, 30976, 31329, 31684, 32041,
+        32400, 32761, 33123, 33488, 33855, 34224, 34595, 34968, 35343, 35720, 36099, 36480,
+        36863, 37248, 37635, 38024, 38415, 38808, 39203, 39600, 39999, 40400, 40803, 41208,
+        41615, 42024, 42435, 42848, 43263, 43680, 44099, 44520, 44943, 45368, 45795, 46224,
+        46655, 47088, 47523, 47960, 48399, 48840, 49283, 49728, 50175, 50624, 51075, 51528,
+        51983, 52440, 52899, 53360, 53823, 54288, 54755, 55224, 55695, 56168, 56643, 57120,
+        57599, 58080, 58563, 59048, 59535, 60024, 60515, 61008, 61503, 62000, 62499, 63000,
+        63503, 64008, 64515, 65024, 65535,
+    },
+};
+
+const rgb_t led_correction_gain[LED_CORRECTION_COUNT] = {
+    [LED_CORRECTION_NONE] = { 255, 255, 255 },
+    [LED_CORRECTION_SMD5050] = { 255, 176, 240 },
+    [LED_CORRECTION_PIXEL_STRING] = { 255, 224, 140 },
+};
+
+const rgb_t led_temperature_gain[LED_TEMPERATURE_STEPS] = {
+    { 255,  68,   0 },   // 1000 K
+    { 255,  77,   0 },   // 1100 K
+    { 255,  86,   0 },   // 1200 K
+    { 255,  94,   0 },   // 1300 K
+    { 255, 101,   0 },   // 1400 K
+    { 255, 108,   0 },   // 1500 K
+    { 255, 115,   0 },   // 1600 K
+    { 255, 121,   0 },   // 1700 K
+    { 255, 126,   0 },   // 1800 K
+    { 255, 132,   0 },   // 1900 K
+    { 255, 137,  14 },   // 2000 K
+    { 255, 142,  27 },   // 2100 K
+    { 255, 146,  39 },   // 2200 K
+    { 255, 151,  50 },   // 2300 K
+    { 255, 155,  61 },   // 2400 K
+    { 255, 159,  70 },   // 2500 K
+    { 255, 163,  79 },   // 2600 K
+    { 255, 167,  87 },   // 2700 K
+    { 255, 170,  95 },   // 2800 K
+    { 255, 174, 103 },   // 2900 K
+    { 255, 177, 110 },   // 3000 K
+    { 255, 180, 117 },   // 3100 K
+    { 255, 184, 123 },   // 3200 K
+    { 255, 187, 129 },   // 3300 K
+    { 255, 190, 135 },   // 3400 K
+    { 255, 193, 141 },   // 3500 K
+    { 255, 195, 146 },   // 3600 K
+    { 255, 198, 151 },   // 3700 K
+    { 255, 201, 157 },   // 3800 K
+    { 255, 203, 161 },   // 3900 K
+    { 255, 206, 166 },   // 4000 K
+    { 255, 208, 171 },   // 4100 K
+    { 255, 211, 175 },   // 4200 K
+    { 255, 213, 179 },   // 4300 K
+    { 255, 215, 183 },   // 4400 K
+    { 255, 218, 187 },   // 4500 K
+    { 255, 220, 191 },   // 4600 K
+    { 255, 222, 195 },   // 4700 K
+    { 255, 224, 199 },   // 4800 K
+    { 255, 226, 202 },   // 4900 K
+    { 255, 228, 206 },   // 5000 K
+    { 255, 230, 209 },   // 5100 K
+    { 255, 232, 213 },   // 5200 K
+    { 255, 234, 216 },   // 5300 K
+    { 255, 236, 219 },   // 5400 K
+    { 255, 237, 222 },   // 5500 K
+    { 255, 239, 225 },   // 5600 K
+    { 255, 241, 228 },   // 5700 K
+    { 255, 243, 231 },   // 5800 K
+    { 255, 244, 234 },   // 5900 K
+    { 255, 246, 237 },   // 6000 K
+    { 255, 248, 240 },   // 6100 K
+    { 255, 249, 242 },   // 6200 K
+    { 255, 251, 245 },   // 6300 K
+    { 255, 253, 248 },   // 6400 K
+    { 255, 254, 250 },   // 6500 K
+    { 255, 255, 255 },   // 6600 K
+    { 254, 249, 255 },   // 6700 K
+    { 250, 246, 255 },   // 6800 K
+    { 246, 244, 255 },   // 6900 K
+    { 243, 242, 255 },   // 7000 K
+    { 240, 240, 255 },   // 7100 K
+    { 237, 239, 255 },   // 7200 K
+    { 234, 237, 255 },   // 7300 K
+    { 232, 236, 255 },   // 7400 K
+    { 230, 235, 255 },   // 7500 K
+    { 228, 234, 255 },   // 7600 K
+    { 226, 233, 255 },   // 7700 K
+    { 224, 232, 255 },   // 7800 K
+    { 223, 231, 255 },   // 7900 K
+    { 221, 230, 255 },   // 8000 K
+    { 220, 229, 255 },   // 8100 K
+    { 218, 228, 255 },   // 8200 K
+    { 217, 227, 255 },   // 8300 K
+    { 216, 227, 255 },   // 8400 K
+    { 215, 226, 255 },   // 8500 K
+    { 214, 225, 255 },   // 8600 K
+    { 213, 225, 255 },   // 8700 K
+    { 212, 224, 255 },   // 8800 K
+    { 211, 223, 255 },   // 8900 K
+    { 210, 223, 255 },   // 9000 K
+    { 209, 222, 255 },   // 9100 K
+    { 208, 222, 255 },   // 9200 K
+    { 207, 221, 255 },   // 9300 K
+    { 206, 221, 255 },   // 9400 K
+    { 205, 220, 255 },   // 9500 K
+    { 205, 220, 255 },   // 9600 K
+    { 204, 219, 255 },   // 9700 K
+    { 203, 219, 255 },   // 9800 K
+    { 202, 218, 255 },   // 9900 K
+    { 202, 218, 255 },   // 10000 K
+    { 201, 218, 255 },   // 10100 K
+    { 200, 217, 255 },   // 10200 K
+    { 200, 217, 255 },   // 10300 K
+    { 199, 217, 255 },   // 10400 K
+    { 199, 216, 255 },   // 10500 K
+    { 198, 216, 255 },   // 10600 K
+    { 197, 215, 255 },   // 10700 K
+    { 197, 215, 255 },   // 10800 K
+    { 196, 215, 255 },   // 10900 K
+    { 196, 214, 255 },   // 11000 K
+    { 195, 214, 255 },   // 11100 K
+    { 195, 214, 255 },   // 11200 K
+    { 194, 213, 255 },   // 11300 K
+    { 194, 213, 255 },   // 11400 K
+    { 193, 213, 255 },   // 11500 K
+    { 193, 213, 255 },   // 11600 K
+    { 192, 212, 255 },   // 11700 K
+    { 192, 212, 255 },   // 11800 K
+    { 192, 212, 255 },   // 11900 K
+    { 191, 211, 255 },   // 12000 K
+};
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Color tables for led_strip_tables.h
+
+- Gamma curves 2.2 / 2.5 / 2.8 / sRGB / custom, as
+  8-bit (256 entries) and 16-bit (257 entries, sampled
+  every 256 codes) tables
+- Color correction presets and color temperature gains
+  (1000 K .. 12000 K in 100 K steps), 255 = unity
+
+Run by the CMake build (the custom exponent comes from
+LED_STRIP_GAMMA_CUSTOM); src/led_strip_tables.c is the
+output at the default exponent for Arduino / PlatformIO:
+
+    tools/gen_tables.py -o src/led_strip_tables.c
+"""
+
+import argparse
+import math
+
+DEFAULT_CUSTOM = 2.0
+
+TEMP_MIN = 1000
+TEMP_MAX = 12000
+TEMP_STEP = 100
+
+# Typical LED die imbalance, as per-channel gains
+CORRECTIONS = [
+    ("NONE",         (255, 255, 255)),
+    ("SMD5050",      (255, 176, 240)),
+    ("PIXEL_STRING", (255, 224, 140)),
+]
+
+
+def srgb(x):
+    return x / 12.92 if x <= 0.04045 else ((x + 0.055) / 1.055) ** 2.4
+
+
+def curves(custom):
+    return [
+        ("2.2",    lambda x: x ** 2.2),
+        ("2.5",    lambda x: x ** 2.5),
+        ("2.8",    lambda x: x ** 2.8),
+        ("sRGB",   srgb),
+        ("custom", lambda x: x ** custom),
+    ]
+
+
+# Black body white point (Tanner Helland's fit), per channel 0..255
+def blackbody(kelvin):
+    t = kelvin / 100.0
+
+    if t <= 66:
+        r = 255.0
+        g = 99.4708025861 * math.log(t) - 161.1195681661
+    else:
+        r = 329.698727446 * (t - 60) ** -0.1332047592
+        g = 288.1221695283 * (t - 60) ** -0.0755148492
+
+    if t >= 66:
+        b = 255.0
+    elif t <= 19:
+        b = 0.0
+    else:
+        b = 138.5177312231 * math.log(t - 10) - 305.0447927307
+
+    return tuple(int(min(255.0, max(0.0, c)) + 0.5) for c in (r, g, b))
+
+
+def rows(values, per_line, width):
+    out = []
+    for i in range(0, len(values), per_line):
+        out.append("        " + " ".join(f"{v:{width}}," for v in values[i:i + per_line]))
+    return "\n".join(out)
+
+
+def generate(custom):
+    lines = [
+        "// Generated by tools/gen_tables.py, do not edit",
+        f"// Custom gamma exponent: {custom}",
+        "",
+        '#include "led_strip_tables.h"',
+        "",
+    ]
+
+    table = curves(custom)
+    temps = range(TEMP_MIN, TEMP_MAX + 1, TEMP_STEP)
+
+    lines += [
+        f'_Static_assert(LED_GAMMA_COUNT == {len(table)}, "gamma curves out of sync with tools/gen_tables.py");',
+        f'_Static_assert(LED_CORRECTION_COUNT == {len(CORRECTIONS)}, "corrections out of sync with tools/gen_tables.py");',
+        f'_Static_assert(LED_TEMPERATURE_STEPS == {len(temps)}, "temperatures out of sync with tools/gen_tables.py");',
+        "",
+        "const uint8_t led_gamma8[LED_GAMMA_COUNT][256] = {",
+    ]
+    for name, f in table:
+        values = [int(f(i / 255.0) * 255.0 + 0.5) for i in range(256)]
+        lines += [f"    {{   // {name}", rows(values, 16, 3), "    },"]
+    lines += ["};", ""]
+
+    lines.append("const uint16_t led_gamma16[LED_GAMMA_COUNT][257] = {")
+    for name, f in table:
+        values = [int(f(i / 256.0) * 65535.0 + 0.5) for i in range(257)]
+        lines += [f"    {{   // {name}", rows(values, 12, 5), "    },"]
+    lines += ["};", ""]
+
+    lines.append("const rgb_t led_correction_gain[LED_CORRECTION_COUNT] = {")
+    for name, (r, g, b) in CORRECTIONS:
+        lines.append(f"    [LED_CORRECTION_{name}] = {{ {r:3}, {g:3}, {b:3} }},")
+    lines += ["};", ""]
+
+    lines.append("const rgb_t led_temperature_gain[LED_TEMPERATURE_STEPS] = {")
+    for k in temps:
+        r, g, b = blackbody(k)
+        lines.append(f"    {{ {r:3}, {g:3}, {b:3} }},   // {k} K")
+    lines += ["};", ""]
+
+    return "\n".join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--custom-gamma", type=float, default=DEFAULT_CUSTOM)
+    args = ap.parse_args()
+
+    if args.custom_gamma <= 0:
+        ap.error("--custom-gamma must be > 0")
+
+    text = generate(args.custom_gamma)
+
+    # Leave the file (and its timestamp) alone when unchanged
+    try:
+        with open(args.output) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+
+    with open(args.output, "w") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()